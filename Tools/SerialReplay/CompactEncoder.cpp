@@ -0,0 +1,449 @@
+/*
+ * CompactEncoder.cpp
+ *
+ * Created: 16/10/2026 10:38:21
+ *  Author: agent
+ *
+ * Converts a line of JSON into a frame in the compact encoding described in SerialIo.cpp: the CBOR self-describe tag, then the object as a CBOR map.
+ * Numbers with a decimal point become decimal fractions so that they arrive with the same digits as in the JSON, and map keys that have
+ * already been sent in the frame are replaced by references where that is shorter. The key numbering follows the same limits as the decoder.
+ */
+
+#include "CompactEncoder.hpp"
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace CompactEncoder
+{
+	// These must match the decoder in SerialIo.cpp
+	const size_t MaxCompactKeys = 128;
+	const size_t CompactKeyPoolSize = 1024;
+	const int MaxCompactExponent = 32;
+
+	struct Value
+	{
+		enum class Type { null, boolean, number, text, array, object };
+
+		Type type = Type::null;
+		bool flag = false;						// the value of a boolean, or true if a number is negative
+		uint64_t mantissa = 0;
+		int exponent = 0;
+		std::string text;
+		std::vector<std::unique_ptr<Value>> elements;
+		std::vector<std::pair<std::string, std::unique_ptr<Value>>> members;
+	};
+
+	class Parser
+	{
+	public:
+		explicit Parser(const std::string& s) : json(s), pos(0) { }
+
+		bool ParseLine(Value& v)
+		{
+			SkipSpace();
+			if (!Peek('{') || !ParseValue(v))
+			{
+				return false;
+			}
+			SkipSpace();
+			return pos == json.size();
+		}
+
+	private:
+		const std::string& json;
+		size_t pos;
+
+		void SkipSpace()
+		{
+			while (pos < json.size() && (json[pos] == ' ' || json[pos] == '\t' || json[pos] == '\r' || json[pos] == '\n'))
+			{
+				++pos;
+			}
+		}
+
+		bool Peek(char c) const
+		{
+			return pos < json.size() && json[pos] == c;
+		}
+
+		bool Take(char c)
+		{
+			SkipSpace();
+			if (Peek(c))
+			{
+				++pos;
+				return true;
+			}
+			return false;
+		}
+
+		bool TakeWord(const char *word)
+		{
+			const std::string w(word);
+			if (json.compare(pos, w.size(), w) == 0)
+			{
+				pos += w.size();
+				return true;
+			}
+			return false;
+		}
+
+		static void AppendUtf8(std::string& s, uint32_t c)
+		{
+			if (c < 0x80)
+			{
+				s += (char)c;
+			}
+			else if (c < 0x800)
+			{
+				s += (char)(0xC0 | (c >> 6));
+				s += (char)(0x80 | (c & 0x3F));
+			}
+			else if (c < 0x10000)
+			{
+				s += (char)(0xE0 | (c >> 12));
+				s += (char)(0x80 | ((c >> 6) & 0x3F));
+				s += (char)(0x80 | (c & 0x3F));
+			}
+			else
+			{
+				s += (char)(0xF0 | (c >> 18));
+				s += (char)(0x80 | ((c >> 12) & 0x3F));
+				s += (char)(0x80 | ((c >> 6) & 0x3F));
+				s += (char)(0x80 | (c & 0x3F));
+			}
+		}
+
+		bool ParseHex4(uint32_t& c)
+		{
+			if (pos + 4 > json.size())
+			{
+				return false;
+			}
+			c = 0;
+			for (int i = 0; i < 4; ++i)
+			{
+				const char h = json[pos++];
+				c <<= 4;
+				if (h >= '0' && h <= '9') { c |= (uint32_t)(h - '0'); }
+				else if (h >= 'a' && h <= 'f') { c |= (uint32_t)(h - 'a' + 10); }
+				else if (h >= 'A' && h <= 'F') { c |= (uint32_t)(h - 'A' + 10); }
+				else { return false; }
+			}
+			return true;
+		}
+
+		bool ParseString(std::string& s)
+		{
+			if (!Take('"'))
+			{
+				return false;
+			}
+			while (pos < json.size())
+			{
+				const char c = json[pos++];
+				if (c == '"')
+				{
+					return true;
+				}
+				if (c != '\\')
+				{
+					s += c;
+					continue;
+				}
+				if (pos == json.size())
+				{
+					return false;
+				}
+				switch (json[pos++])
+				{
+				case '"':	s += '"'; break;
+				case '\\':	s += '\\'; break;
+				case '/':	s += '/'; break;
+				case 'b':	s += '\b'; break;
+				case 'f':	s += '\f'; break;
+				case 'n':	s += '\n'; break;
+				case 'r':	s += '\r'; break;
+				case 't':	s += '\t'; break;
+				case 'u':
+					{
+						uint32_t u;
+						if (!ParseHex4(u))
+						{
+							return false;
+						}
+						if (u >= 0xD800 && u < 0xDC00 && TakeWord("\\u"))
+						{
+							uint32_t low;
+							if (!ParseHex4(low) || low < 0xDC00 || low >= 0xE000)
+							{
+								return false;
+							}
+							u = 0x10000 + ((u - 0xD800) << 10) + (low - 0xDC00);
+						}
+						AppendUtf8(s, u);
+					}
+					break;
+				default:
+					return false;
+				}
+			}
+			return false;
+		}
+
+		bool ParseNumber(Value& v)
+		{
+			v.type = Value::Type::number;
+			v.flag = (json[pos] == '-');
+			if (v.flag)
+			{
+				++pos;
+			}
+			size_t numDigits = 0;
+			int fractionDigits = 0;
+			bool afterPoint = false;
+			for (; pos < json.size(); ++pos)
+			{
+				const char c = json[pos];
+				if (c >= '0' && c <= '9')
+				{
+					if (v.mantissa > (UINT64_MAX - 9)/10)
+					{
+						return false;
+					}
+					v.mantissa = v.mantissa * 10 + (uint64_t)(c - '0');
+					++numDigits;
+					if (afterPoint)
+					{
+						++fractionDigits;
+					}
+				}
+				else if (c == '.' && !afterPoint)
+				{
+					afterPoint = true;
+				}
+				else
+				{
+					break;
+				}
+			}
+			int exponent = 0;
+			if (pos < json.size() && (json[pos] == 'e' || json[pos] == 'E'))
+			{
+				++pos;
+				const bool negativeExponent = Peek('-');
+				if (negativeExponent || Peek('+'))
+				{
+					++pos;
+				}
+				if (pos == json.size() || json[pos] < '0' || json[pos] > '9')
+				{
+					return false;
+				}
+				for (; pos < json.size() && json[pos] >= '0' && json[pos] <= '9' && exponent < 1000; ++pos)
+				{
+					exponent = exponent * 10 + (json[pos] - '0');
+				}
+				if (negativeExponent)
+				{
+					exponent = -exponent;
+				}
+			}
+			v.exponent = exponent - fractionDigits;
+			return numDigits != 0 && v.exponent >= -MaxCompactExponent && v.exponent <= MaxCompactExponent;
+		}
+
+		bool ParseValue(Value& v)
+		{
+			SkipSpace();
+			if (pos == json.size())
+			{
+				return false;
+			}
+			switch (json[pos])
+			{
+			case '{':
+				++pos;
+				v.type = Value::Type::object;
+				if (Take('}'))
+				{
+					return true;
+				}
+				do
+				{
+					std::string key;
+					std::unique_ptr<Value> member(new Value);
+					if (!ParseString(key) || !Take(':') || !ParseValue(*member))
+					{
+						return false;
+					}
+					v.members.emplace_back(std::move(key), std::move(member));
+				} while (Take(','));
+				return Take('}');
+
+			case '[':
+				++pos;
+				v.type = Value::Type::array;
+				if (Take(']'))
+				{
+					return true;
+				}
+				do
+				{
+					std::unique_ptr<Value> element(new Value);
+					if (!ParseValue(*element))
+					{
+						return false;
+					}
+					v.elements.push_back(std::move(element));
+				} while (Take(','));
+				return Take(']');
+
+			case '"':
+				v.type = Value::Type::text;
+				return ParseString(v.text);
+
+			case 't':
+				v.type = Value::Type::boolean;
+				v.flag = true;
+				return TakeWord("true");
+
+			case 'f':
+				v.type = Value::Type::boolean;
+				return TakeWord("false");
+
+			case 'n':
+				v.type = Value::Type::null;
+				return TakeWord("null");
+
+			default:
+				return (json[pos] == '-' || (json[pos] >= '0' && json[pos] <= '9')) && ParseNumber(v);
+			}
+		}
+	};
+
+	class Writer
+	{
+	public:
+		explicit Writer(std::string& f) : frame(f), numKeys(0), keyPoolUsed(0) { }
+
+		void Write(const Value& v)
+		{
+			switch (v.type)
+			{
+			case Value::Type::null:
+				frame += '\xF6';
+				break;
+
+			case Value::Type::boolean:
+				frame += (v.flag) ? '\xF5' : '\xF4';
+				break;
+
+			case Value::Type::number:
+				if (v.exponent != 0)
+				{
+					WriteHead(6, 4);				// decimal fraction
+					WriteHead(4, 2);
+					WriteInteger(v.exponent < 0, (uint64_t)((v.exponent < 0) ? -v.exponent : v.exponent));
+				}
+				WriteInteger(v.flag, v.mantissa);
+				break;
+
+			case Value::Type::text:
+				WriteHead(3, v.text.size());
+				frame += v.text;
+				break;
+
+			case Value::Type::array:
+				WriteHead(4, v.elements.size());
+				for (const auto& e : v.elements)
+				{
+					Write(*e);
+				}
+				break;
+
+			case Value::Type::object:
+				WriteHead(5, v.members.size());
+				for (const auto& m : v.members)
+				{
+					WriteKey(m.first);
+					Write(*m.second);
+				}
+				break;
+			}
+		}
+
+	private:
+		std::string& frame;
+		std::map<std::string, size_t> keyNumbers;
+		size_t numKeys;
+		size_t keyPoolUsed;
+
+		static size_t HeadLength(uint64_t arg)
+		{
+			return (arg < 24) ? 1 : (arg <= 0xFF) ? 2 : (arg <= 0xFFFF) ? 3 : (arg <= 0xFFFFFFFF) ? 5 : 9;
+		}
+
+		void WriteHead(uint8_t majorType, uint64_t arg)
+		{
+			const size_t length = HeadLength(arg);
+			static const uint8_t additionalInfo[] = { 0, 0, 24, 25, 0, 26, 0, 0, 0, 27 };
+			frame += (char)((majorType << 5) | ((length == 1) ? arg : additionalInfo[length]));
+			for (size_t i = length - 1; i != 0; --i)
+			{
+				frame += (char)(arg >> (8 * (i - 1)));
+			}
+		}
+
+		void WriteInteger(bool negative, uint64_t magnitude)
+		{
+			if (negative && magnitude != 0)
+			{
+				WriteHead(1, magnitude - 1);
+			}
+			else
+			{
+				WriteHead(0, magnitude);
+			}
+		}
+
+		// Send a key as a reference if we can and it is shorter, else as text, numbering it as the decoder will
+		void WriteKey(const std::string& key)
+		{
+			const auto found = keyNumbers.find(key);
+			if (found != keyNumbers.end() && HeadLength(found->second) <= HeadLength(key.size()) + key.size())
+			{
+				WriteHead(0, found->second);
+				return;
+			}
+
+			WriteHead(3, key.size());
+			frame += key;
+			if (numKeys < MaxCompactKeys && keyPoolUsed + key.size() <= CompactKeyPoolSize)
+			{
+				keyPoolUsed += key.size();
+				keyNumbers[key] = numKeys++;			// if the same key is stored again, the later number is as good as the earlier one
+			}
+		}
+	};
+
+	bool Encode(const std::string& json, std::string& frame)
+	{
+		Value root;
+		Parser parser(json);
+		if (!parser.ParseLine(root))
+		{
+			return false;
+		}
+
+		frame = "\xD9\xD9\xF7";
+		Writer writer(frame);
+		writer.Write(root);
+		frame += '\n';
+		return true;
+	}
+}
+
+// End
@@ -0,0 +1,23 @@
+/*
+ * CompactEncoder.hpp
+ *
+ * Created: 16/10/2026 10:38:21
+ *  Author: agent
+ *
+ * Converts a line of JSON from RepRapFirmware into a frame in the compact encoding that SerialIo.cpp decodes,
+ * as a host that supports the compact encoding would send it.
+ */
+
+#ifndef COMPACTENCODER_HPP_
+#define COMPACTENCODER_HPP_
+
+#include <string>
+
+namespace CompactEncoder
+{
+	// Encode a JSON object, which may end with a newline, as a frame followed by a newline.
+	// Returns false if the line isn't a JSON object that the compact encoding can represent.
+	bool Encode(const std::string& json, std::string& frame);
+}
+
+#endif /* COMPACTENCODER_HPP_ */
@@ -0,0 +1,131 @@
+/*
+ * HostUart.cpp
+ *
+ * Created: 16/10/2026 10:27:43
+ *  Author: agent
+ *
+ * Simulation of the UART and its PDC channels, so that the real SerialIo.cpp can be run on the host.
+ * Transfers complete instantly: a transmit transfer is finished as soon as its ENDTX interrupt is enabled,
+ * and received characters are written straight into the buffer that the PDC receive pointer addresses.
+ */
+
+#include "HostUart.hpp"
+#include "asf.h"
+
+Uart hostUart;
+Pio hostPio;
+Rstc hostRstc;
+Wdt hostWdt;
+uint32_t SystemCoreClock = 120000000;
+
+namespace HostUart
+{
+	static size_t transmittedCount = 0;
+	static bool inTransmit = false;
+
+	static char *AddressOf(uint32_t reg)
+	{
+		return reinterpret_cast<char *>(static_cast<uintptr_t>(reg));
+	}
+
+	// Run the interrupt handler for the given status bits, as the hardware would if they are enabled
+	static void Interrupt(uint32_t status)
+	{
+		hostUart.UART_SR |= status;
+		if ((hostUart.UART_IMR & status) != 0)
+		{
+			UART0_Handler();
+		}
+		hostUart.UART_SR &= ~status;
+	}
+
+	// Move the next receive buffer into the current one, if there is one
+	static void LoadNextReceiveBuffer()
+	{
+		if (hostUart.UART_RNCR != 0)
+		{
+			hostUart.UART_RPR = hostUart.UART_RNPR;
+			hostUart.UART_RCR = hostUart.UART_RNCR;
+			hostUart.UART_RNCR = 0;
+		}
+	}
+
+	size_t Receive(const char *data, size_t length)
+	{
+		for (size_t i = 0; i < length; ++i)
+		{
+			if (hostUart.UART_RCR == 0)
+			{
+				Interrupt(UART_SR_OVRE);
+				return i;
+			}
+			*AddressOf(hostUart.UART_RPR) = data[i];
+			++hostUart.UART_RPR;
+			if (--hostUart.UART_RCR == 0)
+			{
+				LoadNextReceiveBuffer();
+				Interrupt(UART_SR_ENDRX);
+			}
+		}
+		return length;
+	}
+
+	size_t GetTransmittedCount()
+	{
+		return transmittedCount;
+	}
+
+	// Complete any transmit transfer that has been set up. The handler may start another one, so keep going until it doesn't.
+	static void Transmit()
+	{
+		if (!inTransmit)
+		{
+			inTransmit = true;
+			while ((hostUart.UART_IMR & UART_SR_ENDTX) != 0 && hostUart.UART_TCR != 0)
+			{
+				transmittedCount += hostUart.UART_TCR;
+				hostUart.UART_TPR += hostUart.UART_TCR;
+				hostUart.UART_TCR = 0;
+				Interrupt(UART_SR_ENDTX);
+			}
+			inTransmit = false;
+		}
+	}
+}
+
+uint32_t uart_init(Uart *p_uart, const sam_uart_opt *p_uart_opt)
+{
+	return 0;
+}
+
+void uart_enable_interrupt(Uart *p_uart, uint32_t ul_sources)
+{
+	p_uart->UART_IMR |= ul_sources;
+	if ((ul_sources & UART_SR_ENDTX) != 0)
+	{
+		HostUart::Transmit();
+	}
+}
+
+void uart_disable_interrupt(Uart *p_uart, uint32_t ul_sources)
+{
+	p_uart->UART_IMR &= ~ul_sources;
+}
+
+// The harness has no non-volatile memory, so reads leave the caller's default values alone
+uint32_t flash_read_user_signature(uint32_t *p_data, uint32_t ul_size)
+{
+	return 0;
+}
+
+uint32_t flash_write_user_signature(const void *p_buffer, uint32_t ul_size)
+{
+	return 0;
+}
+
+uint32_t flash_erase_user_signature()
+{
+	return 0;
+}
+
+// End
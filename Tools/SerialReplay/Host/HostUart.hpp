@@ -0,0 +1,25 @@
+/*
+ * HostUart.hpp
+ *
+ * Created: 16/10/2026 10:27:43
+ *  Author: agent
+ *
+ * Simulation of the UART and its PDC channels, so that the real SerialIo.cpp can be run on the host.
+ */
+
+#ifndef HOSTUART_HPP_
+#define HOSTUART_HPP_
+
+#include <cstddef>
+
+namespace HostUart
+{
+	// Deliver characters to the receiver as if they had arrived on the wire, running the interrupt handler as the PDC completes each block.
+	// Returns the number of characters accepted. If the PDC runs out of buffer the UART reports an overrun and the rest are lost.
+	size_t Receive(const char *data, size_t length);
+
+	// Return the number of characters that the PDC has transmitted
+	size_t GetTransmittedCount();
+}
+
+#endif /* HOSTUART_HPP_ */
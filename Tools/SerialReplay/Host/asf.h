@@ -0,0 +1,127 @@
+/*
+ * asf.h
+ *
+ *  Created on: 16 Oct 2026
+ *
+ *  Stand-in for the ASF headers when building the serial parser for the host.
+ *  It is force-included ahead of everything else and uses the same include guard as src/asf.h, so the real one is never read.
+ *  Only the registers and driver calls that SerialIo.cpp and PanelDue.cpp use are provided. The UART and its PDC channels are simulated in HostUart.cpp.
+ */
+
+#ifndef ASF_H
+#define ASF_H
+
+#include <cstddef>
+#include <cstdint>
+
+#define SAM4S	1
+#define SAM3S	0
+
+// The PDC registers hold buffer addresses, so the harness must be linked at addresses below 4GB (see -no-pie in the Makefile)
+struct Uart
+{
+	uint32_t UART_CR, UART_MR, UART_IER, UART_IDR, UART_IMR, UART_SR, UART_RHR, UART_THR, UART_BRGR;
+	uint32_t UART_RPR, UART_RCR, UART_TPR, UART_TCR, UART_RNPR, UART_RNCR, UART_TNPR, UART_TNCR, UART_PTCR, UART_PTSR;
+};
+
+struct Pio
+{
+	uint32_t PIO_PER, PIO_OER, PIO_ODR, PIO_SODR, PIO_CODR, PIO_PDSR;
+};
+
+struct Rstc
+{
+	uint32_t RSTC_CR, RSTC_SR, RSTC_MR;
+};
+
+struct Wdt
+{
+	uint32_t WDT_CR, WDT_MR, WDT_SR;
+};
+
+extern Uart hostUart;
+extern Pio hostPio;
+extern Rstc hostRstc;
+extern Wdt hostWdt;
+extern uint32_t SystemCoreClock;
+
+#define UART0		(&hostUart)
+#define UART1		(&hostUart)
+#define PIOA		(&hostPio)
+#define PIOB		(&hostPio)
+#define RSTC		(&hostRstc)
+#define WDT			(&hostWdt)
+
+#define UART_SR_RXRDY		(1u << 0)
+#define UART_SR_TXRDY		(1u << 1)
+#define UART_SR_ENDRX		(1u << 3)
+#define UART_SR_ENDTX		(1u << 4)
+#define UART_SR_OVRE		(1u << 5)
+#define UART_SR_FRAME		(1u << 6)
+#define UART_IER_ENDRX		UART_SR_ENDRX
+#define UART_IER_ENDTX		UART_SR_ENDTX
+#define UART_IER_OVRE		UART_SR_OVRE
+#define UART_IER_FRAME		UART_SR_FRAME
+#define UART_IDR_ENDRX		UART_SR_ENDRX
+#define UART_IDR_ENDTX		UART_SR_ENDTX
+#define UART_IMR_ENDRX		UART_SR_ENDRX
+#define UART_CR_RSTSTA		(1u << 8)
+#define UART_PTCR_RXTEN		(1u << 0)
+#define UART_PTCR_TXTEN		(1u << 8)
+#define US_MR_PAR_NO		(0)
+
+#define PIO_PERIPH_A		(0)
+#define PIO_INPUT			(5)
+#define PIO_OUTPUT_0		(6)
+#define PIO_PULLUP			(1u << 0)
+#define PIO_PA9				(1u << 9)
+#define PIO_PA10			(1u << 10)
+#define PIO_PB2				(1u << 2)
+#define PIO_PB3				(1u << 3)
+
+#define ID_UART0			(8)
+#define ID_UART1			(9)
+#define ID_PIOA				(11)
+#define ID_PIOB				(12)
+#define ID_PWM				(31)
+#define UART0_IRQn			(8)
+#define UART1_IRQn			(9)
+
+#define CCFG_SYSIO_SYSIO4	(1u << 4)
+#define CCFG_SYSIO_SYSIO5	(1u << 5)
+#define CCFG_SYSIO_SYSIO6	(1u << 6)
+#define CCFG_SYSIO_SYSIO7	(1u << 7)
+#define RSTC_SOFTWARE_RESET	(3)
+#define WDT_MR_WDRSTEN		(1u << 13)
+
+struct sam_uart_opt
+{
+	uint32_t ul_mck;
+	uint32_t ul_baudrate;
+	uint32_t ul_mode;
+};
+
+uint32_t uart_init(Uart *p_uart, const sam_uart_opt *p_uart_opt);
+void uart_enable_interrupt(Uart *p_uart, uint32_t ul_sources);
+void uart_disable_interrupt(Uart *p_uart, uint32_t ul_sources);
+
+uint32_t flash_read_user_signature(uint32_t *p_data, uint32_t ul_size);
+uint32_t flash_write_user_signature(const void *p_buffer, uint32_t ul_size);
+uint32_t flash_erase_user_signature();
+
+inline uint32_t pio_configure(Pio *p_pio, uint32_t ul_type, uint32_t ul_mask, uint32_t ul_attribute) { return 1; }
+inline uint32_t pmc_enable_periph_clk(uint32_t ul_id) { return 0; }
+inline uint32_t sysclk_get_main_hz() { return 120000000; }
+inline void irq_register_handler(int irqn, int priority) { }
+typedef uint32_t irqflags_t;
+inline irqflags_t cpu_irq_save() { return 0; }
+inline void cpu_irq_restore(irqflags_t flags) { }
+inline void matrix_set_system_io(uint32_t ul_io) { }
+inline uint32_t rstc_get_reset_cause(Rstc *p_rstc) { return 0; }
+inline void wdt_init(Wdt *p_wdt, uint32_t ul_mode, uint16_t us_counter, uint16_t us_delta) { }
+inline void SystemInit() { }
+inline uint32_t SysTick_Config(uint32_t ticks) { return 0; }
+
+extern "C" void UART0_Handler();
+
+#endif /* ASF_H */
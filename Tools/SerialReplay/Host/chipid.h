@@ -0,0 +1,7 @@
+/*
+ * chipid.h
+ *
+ *  Created on: 16 Oct 2026
+ *
+ *  Empty stand-in for the ASF header, which src/Hardware/Mem.hpp includes. See asf.h.
+ */
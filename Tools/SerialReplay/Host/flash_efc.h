@@ -0,0 +1,7 @@
+/*
+ * flash_efc.h
+ *
+ *  Created on: 16 Oct 2026
+ *
+ *  Empty stand-in for the ASF header. The flash functions that PanelDue.cpp uses are declared in asf.h.
+ */
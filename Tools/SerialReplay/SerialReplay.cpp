@@ -0,0 +1,289 @@
+/*
+ * SerialReplay.cpp
+ *
+ * Created: 16/10/2026 10:27:43
+ *  Author: agent
+ *
+ * Replays transcripts of what RepRapFirmware sends to PanelDue through the real SerialIo parser and the received data handling in PanelDue.cpp,
+ * and reports how long they took. The display and other hardware are stubbed out, so the times are for parsing and dispatching only.
+ * A transcript is a file of JSON messages, one per line, exactly as they arrive on the wire.
+ * With -b the messages are converted to the compact encoding first, as a host that supports it would send them.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <string>
+#include <vector>
+#include "PanelDue.hpp"
+#include "Hardware/SerialIo.hpp"
+#include "Host/HostUart.hpp"
+#include "CompactEncoder.hpp"
+
+typedef std::chrono::steady_clock Clock;
+
+struct Transcript
+{
+	const char *name;
+	std::vector<std::string> lines;
+	size_t numBytes = 0;
+
+	// Totals over all the replays
+	size_t numMessages = 0;
+	size_t numValues = 0;
+	size_t numArrayEnds = 0;
+	Clock::duration time = Clock::duration::zero();
+	std::vector<Clock::duration> lineTimes;		// the fastest replay of each line, which is the least disturbed by the host OS
+};
+
+static size_t numMessages = 0;
+static size_t numValues = 0;
+static size_t numArrayEnds = 0;
+static size_t numErrors = 0;
+static bool verbose = false;
+static bool compact = false;
+
+// SerialIo.cpp is compiled with its callbacks renamed to these, so that we can count them before passing them on to PanelDue.cpp
+void ReplayStartReceivedMessage()
+{
+	StartReceivedMessage();
+}
+
+void ReplayEndReceivedMessage()
+{
+	++numMessages;
+	EndReceivedMessage();
+}
+
+void ReplayParserErrorEncountered()
+{
+	++numErrors;
+	ParserErrorEncountered();
+}
+
+void ReplayProcessReceivedValue(uint32_t idHash, const ReceivedValue& val, const size_t indices[])
+{
+	++numValues;
+	if (verbose)
+	{
+		printf("  value %08x [%u %u] \"%s\"\n", (unsigned int)idHash, (unsigned int)indices[0], (unsigned int)indices[1], val.text);
+	}
+	ProcessReceivedValue(idHash, val, indices);
+}
+
+void ReplayProcessArrayEnd(uint32_t idHash, const size_t indices[])
+{
+	++numArrayEnds;
+	if (verbose)
+	{
+		printf("  array end %08x [%u %u]\n", (unsigned int)idHash, (unsigned int)indices[0], (unsigned int)indices[1]);
+	}
+	ProcessArrayEnd(idHash, indices);
+}
+
+static void AddLine(Transcript& t, const std::string& line)
+{
+	std::string frame;
+	const std::string& received = (compact && CompactEncoder::Encode(line, frame)) ? frame : line;
+	t.numBytes += received.size();
+	t.lines.push_back(received);
+	t.lineTimes.push_back(Clock::duration::max());
+}
+
+static bool ReadTranscript(Transcript& t)
+{
+	FILE *f = fopen(t.name, "rb");
+	if (f == nullptr)
+	{
+		fprintf(stderr, "Can't open %s\n", t.name);
+		return false;
+	}
+
+	std::string line;
+	int c;
+	while ((c = getc(f)) != EOF)
+	{
+		line += (char)c;
+		if (c == '\n')
+		{
+			AddLine(t, line);
+			line.clear();
+		}
+	}
+	fclose(f);
+	if (!line.empty())
+	{
+		line += '\n';								// the parser only finishes a message when the line ends
+		AddLine(t, line);
+	}
+	return true;
+}
+
+// Feed one line to the receiver a chunk at a time, parsing after each chunk as the main loop would, and return the time spent parsing
+static Clock::duration ReplayLine(const std::string& line, size_t chunkSize)
+{
+	Clock::duration time = Clock::duration::zero();
+	for (size_t done = 0; done < line.size(); )
+	{
+		const size_t len = std::min(chunkSize, line.size() - done);
+		if (HostUart::Receive(line.data() + done, len) != len)
+		{
+			fprintf(stderr, "Receive buffer overrun; use a smaller chunk size\n");
+			exit(1);
+		}
+		done += len;
+
+		const Clock::time_point start = Clock::now();
+		SerialIo::CheckInput();
+		time += Clock::now() - start;
+	}
+	return time;
+}
+
+static double Microseconds(Clock::duration d)
+{
+	return std::chrono::duration<double, std::micro>(d).count();
+}
+
+static void Usage()
+{
+	fprintf(stderr,
+			"Usage: serialreplay [-n iterations] [-c chunk-size] [-b] [-v] transcript...\n"
+			"  -n  number of times to replay the transcripts (default 100)\n"
+			"  -c  characters received between calls to CheckInput (default 512)\n"
+			"  -b  send the messages in the compact encoding instead of JSON\n"
+			"  -v  list the values received, and replay once\n");
+	exit(1);
+}
+
+int main(int argc, char *argv[])
+{
+	size_t iterations = 100;
+	size_t chunkSize = 512;
+	std::vector<Transcript> transcripts;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		if (strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+		{
+			iterations = strtoul(argv[++i], nullptr, 10);
+		}
+		else if (strcmp(argv[i], "-c") == 0 && i + 1 < argc)
+		{
+			chunkSize = strtoul(argv[++i], nullptr, 10);
+		}
+		else if (strcmp(argv[i], "-v") == 0)
+		{
+			verbose = true;
+		}
+		else if (strcmp(argv[i], "-b") == 0)
+		{
+			compact = true;
+		}
+		else if (argv[i][0] == '-')
+		{
+			Usage();
+		}
+		else
+		{
+			transcripts.emplace_back();
+			transcripts.back().name = argv[i];
+		}
+	}
+	if (transcripts.empty() || iterations == 0 || chunkSize == 0)
+	{
+		Usage();
+	}
+	for (Transcript& t : transcripts)
+	{
+		if (!ReadTranscript(t))
+		{
+			return 1;
+		}
+	}
+	if (verbose)
+	{
+		iterations = 1;
+	}
+
+	SetBaudRate(57600);						// this initialises SerialIo, and PanelDue.cpp uses the baud rate to time responses
+
+	for (size_t n = 0; n < iterations; ++n)
+	{
+		for (Transcript& t : transcripts)
+		{
+			if (verbose)
+			{
+				printf("%s\n", t.name);
+			}
+			const size_t messagesBefore = numMessages, valuesBefore = numValues, arrayEndsBefore = numArrayEnds;
+			for (size_t line = 0; line < t.lines.size(); ++line)
+			{
+				const Clock::duration lineTime = ReplayLine(t.lines[line], chunkSize);
+				t.time += lineTime;
+				t.lineTimes[line] = std::min(t.lineTimes[line], lineTime);
+			}
+			t.numMessages += numMessages - messagesBefore;
+			t.numValues += numValues - valuesBefore;
+			t.numArrayEnds += numArrayEnds - arrayEndsBefore;
+		}
+	}
+
+	printf("%-32s %8s %8s %8s %10s %10s %10s\n", "Transcript", "Messages", "Bytes", "Values", "Calls/msg", "us/msg", "Max us");
+	size_t totalBytes = 0, totalMessages = 0, maxLine = 0;
+	Clock::duration totalTime = Clock::duration::zero(), maxTime = Clock::duration::zero();
+	const Transcript *maxTranscript = nullptr;
+	for (const Transcript& t : transcripts)
+	{
+		Clock::duration maxLineTime = Clock::duration::zero();
+		size_t slowestLine = 0;
+		for (size_t line = 0; line < t.lines.size(); ++line)
+		{
+			if (t.lineTimes[line] > maxLineTime)
+			{
+				maxLineTime = t.lineTimes[line];
+				slowestLine = line + 1;
+			}
+		}
+		if (maxLineTime > maxTime)
+		{
+			maxTime = maxLineTime;
+			maxTranscript = &t;
+			maxLine = slowestLine;
+		}
+
+		const double messages = (double)t.numMessages / iterations;
+		printf("%-32s %8.0f %8u %8.0f %10.1f %10.2f %10.2f\n",
+				t.name,
+				messages,
+				(unsigned int)t.numBytes,
+				(double)t.numValues / iterations,
+				(t.numMessages == 0) ? 0.0 : (double)(t.numValues + t.numArrayEnds) / t.numMessages,
+				(t.numMessages == 0) ? 0.0 : Microseconds(t.time) / t.numMessages,
+				Microseconds(maxLineTime));
+		totalBytes += t.numBytes * iterations;
+		totalMessages += t.numMessages;
+		totalTime += t.time;
+	}
+
+	const double seconds = std::chrono::duration<double>(totalTime).count();
+	printf("\n%u bytes, %u messages, %u values and %u array ends in %.3f ms\n",
+			(unsigned int)totalBytes, (unsigned int)totalMessages, (unsigned int)numValues, (unsigned int)numArrayEnds, seconds * 1000.0);
+	if (seconds > 0.0)
+	{
+		printf("%.2f MB/s, %.0f values/s, %.1f callbacks per message\n",
+				totalBytes/(seconds * 1.0e6),
+				numValues/seconds,
+				(totalMessages == 0) ? 0.0 : (double)(numValues + numArrayEnds)/totalMessages);
+	}
+	if (maxTranscript != nullptr)
+	{
+		printf("Slowest message %.2f us at %s line %u\n", Microseconds(maxTime), maxTranscript->name, (unsigned int)maxLine);
+	}
+	printf("Parser errors: %u, characters transmitted: %u\n", (unsigned int)numErrors, (unsigned int)HostUart::GetTransmittedCount());
+	return (numErrors == 0) ? 0 : 1;
+}
+
+// End
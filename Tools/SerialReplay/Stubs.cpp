@@ -0,0 +1,199 @@
+/*
+ * Stubs.cpp
+ *
+ * Created: 16/10/2026 10:27:43
+ *  Author: agent
+ *
+ * Do-nothing versions of the display, touch, buzzer and user interface functions that PanelDue.cpp calls,
+ * so that the received data handling can be run on the host without any hardware.
+ */
+
+#include <chrono>
+#include "PanelDue.hpp"
+#include "Display.hpp"
+#include "UserInterface.hpp"
+#include "ObjectModel.hpp"
+#include "FileManager.hpp"
+#include "MessageLog.hpp"
+#include "Hardware/UTouch.hpp"
+#include "Hardware/Buzzer.hpp"
+#include "Hardware/SysTick.hpp"
+#include "Hardware/Reset.hpp"
+#include "Hardware/Mem.hpp"
+#include "Icons/Icons.hpp"
+
+uint16_t _esplash[2] = { 0, 0 };
+const uint16_t IconPaletteLight[1] = { 0 };			// referenced by the colour schemes
+const uint16_t IconPaletteDark[1] = { 0 };
+
+IntegerField *freeMem = nullptr;
+StaticTextField *debugField = nullptr;
+StaticTextField *touchCalibInstruction = nullptr;
+TextField *fwVersionField = nullptr;
+
+// Hardware
+void InitMemory() { }
+uint32_t GetFreeMemory() { return 0; }
+
+void Reset() noexcept
+{
+	for (;;) { }
+}
+
+void EraseAndReset() noexcept
+{
+	for (;;) { }
+}
+
+namespace SystemTick
+{
+	uint32_t GetTickCount()
+	{
+		static const auto start = std::chrono::steady_clock::now();
+		return (uint32_t)std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+	}
+}
+
+namespace Buzzer
+{
+	void Init() { }
+	void Beep(uint32_t frequency, uint32_t ms, uint32_t volume) { }
+	bool Noisy() { return false; }
+	void SetBacklight(uint32_t brightness) { }
+}
+
+UTFT::UTFT(DisplayType model, unsigned int RS, unsigned int WR, unsigned int CS, unsigned int RST, unsigned int SER_LATCH)
+	: portRS(RS), portWR(WR), portCS(CS), portRST(RST), portSDA(SER_LATCH), portSCL(SER_LATCH)
+{
+}
+
+void UTFT::InitLCD(DisplayOrientation po, bool is24bit, bool isER) { }
+void UTFT::setOrientation(DisplayOrientation o, bool isER, bool getCS) { }
+void UTFT::fillScr(Colour c, uint16_t leftMargin) { }
+void UTFT::fillCircle(int x, int y, int radius) { }
+void UTFT::drawCompressedBitmapBottomToTop(int x, int y, int sx, int sy, const uint16_t *data) { }
+size_t UTFT::write(uint8_t c) { return 1; }
+int UTFT::printf(const char* fmt, ...) noexcept { return 0; }
+
+UTouch::UTouch(unsigned int tclk, unsigned int tcs, unsigned int tdin, unsigned int dout, unsigned int irq)
+	: portCLK(tclk), portCS(tcs), portDIN(tdin), portDOUT(dout), portIRQ(irq)
+{
+}
+
+void UTouch::init(uint16_t xp, uint16_t yp, DisplayOrientation orientationAdjust) { }
+bool UTouch::read(uint16_t &x, uint16_t &y, uint16_t *rawX, uint16_t *rawY) { return false; }
+void UTouch::calibrate(uint16_t xlow, uint16_t xhigh, uint16_t ylow, uint16_t yhigh, uint16_t margin) { }
+
+// Display
+ButtonPress::ButtonPress() : button(nullptr), index(0) { }
+event_t ButtonPress::GetEvent() const { return nullEvent; }
+void DisplayField::Show(bool v) { }
+void DisplayField::SetChanged() { }
+Window::Window(Colour pb) : root(nullptr), next(nullptr), backgroundColour(pb) { }
+ButtonPress Window::FindEvent(PixelNumber x, PixelNumber y) { return ButtonPress(); }
+ButtonPress Window::FindEventOutsidePopup(PixelNumber x, PixelNumber y) { return ButtonPress(); }
+MainWindow::MainWindow() : Window(0), staticLeftMargin(0) { }
+void MainWindow::Refresh(bool full) { }
+void MainWindow::SetRoot(DisplayField * null r) { root = r; }
+bool MainWindow::Contains(PixelNumber xmin, PixelNumber ymin, PixelNumber xmax, PixelNumber ymax) const { return false; }
+
+namespace MessageLog
+{
+	void Init() { }
+	void AppendMessage(const char* data) { }
+	void AppendMessage(size_t maxLen, const char* format, ...) { }
+	void BeginNewMessage() { }
+	void SaveMessage(const char* data) { }
+	void DisplayNewMessage() { }
+}
+
+namespace FileManager
+{
+	void BeginNewMessage() { }
+	void EndReceivedMessage() { }
+	void BeginReceivingFiles() { }
+	void ReceiveFile(const char * _ecv_array data) { }
+	void ReceiveDirectoryName(const char * _ecv_array data) { }
+	void ReceiveErrorCode(int err) { }
+	bool ProcessTimers() { return false; }
+	void SetNumVolumes(size_t n) { }
+	void FirmwareFeaturesChanged() { }
+}
+
+namespace OM
+{
+	size_t RemoveAxis(const size_t index, const bool allFollowing) { return 0; }
+	size_t RemoveSpindle(const size_t index, const bool allFollowing) { return 0; }
+	size_t RemoveTool(const size_t index, const bool allFollowing) { return 0; }
+	size_t RemoveBed(const size_t index, const bool allFollowing) { return 0; }
+	size_t RemoveChamber(const size_t index, const bool allFollowing) { return 0; }
+}
+
+namespace UI
+{
+	unsigned int GetNumLanguages() { return 1; }
+	void CreateFields(uint32_t language, const ColourScheme& colours, uint32_t p_infoTimeout) { }
+	void ActivateScreensaver() { }
+	void DeactivateScreensaver() { }
+	void AnimateScreensaver() { }
+	void UpdateAxisPosition(size_t axis, float fval) { }
+	void UpdateCurrentTemperature(size_t heater, float fval) { }
+	void UpdateHeaterStatus(const size_t heater, const HeaterStatus status) { }
+	void ChangeStatus(PrinterStatus oldStatus, PrinterStatus newStatus) { }
+	void UpdateTimesLeft(size_t index, unsigned int seconds) { }
+	bool DoPolling() { return true; }
+	DisplayedView GetDisplayedView() { return DisplayedView::control; }
+	void Spin() { }
+	void PrintingFilenameChanged(const char data[]) { }
+	void LastJobFileNameAvailable(const bool available) { }
+	void SetLastFileSimulated(const bool lastFileSimulated) { }
+	void ShowDefaultPage() { }
+	void UpdatePrintingFields() { }
+	void SetPrintProgressPercent(unsigned int percent) { }
+	void UpdateGeometry(unsigned int p_numAxes, bool p_isDelta) { }
+	void UpdateHomedStatus(size_t axis, bool isHomed) { }
+	void UpdateZProbe(const char data[]) { }
+	void UpdateMachineName(const char data[]) { }
+	void UpdateIP(const char data[]) { }
+	void ProcessAlert(const Alert& alert) { }
+	void ClearAlert() { }
+	void ProcessSimpleAlert(const char* _ecv_array text) { }
+	bool CanDimDisplay() { return false; }
+	void UpdateFileLastModifiedText(const char data[]) { }
+	void UpdateFileGeneratedByText(const char data[]) { }
+	void UpdateFileObjectHeight(float f) { }
+	void UpdateFileLayerHeight(float f) { }
+	void UpdateFileSize(int size) { }
+	void UpdateFileFilament(int len) { }
+	void UpdateFanPercent(size_t fanIndex, int rpm) { }
+	void UpdateActiveTemperature(size_t index, int ival) { }
+	void UpdateToolTemp(size_t toolIndex, int32_t temp, bool active) { }
+	void UpdateStandbyTemperature(size_t index, int ival) { }
+	void UpdateExtrusionFactor(size_t index, int ival) { }
+	void UpdatePrintTimeText(uint32_t seconds, bool isSimulated) { }
+	void UpdateSpeedPercent(int ival) { }
+	void FirmwareFeaturesChanged(FirmwareFeatures newFeatures) { }
+	void ProcessTouch(ButtonPress bp) { }
+	void ProcessTouchOutsidePopup(ButtonPress bp) { }
+	void OnButtonPressTimeout() { }
+	void AllToolsSeen() { }
+	void SetBabystepOffset(size_t index, float f) { }
+	void SetAxisLetter(size_t index, char l) { }
+	void SetAxisVisible(size_t index, bool v) { }
+	void SetAxisWorkplaceOffset(size_t axisIndex, size_t workplaceIndex, float offset) { }
+	void SetCurrentWorkplaceNumber(uint8_t workplaceNumber) { }
+	void SetCurrentTool(int32_t tool) { }
+	void UpdateToolStatus(size_t index, ToolStatus status) { }
+	void SetToolExtruder(size_t toolIndex, int8_t extruder) { }
+	void SetToolFan(size_t toolIndex, int8_t fan) { }
+	void SetToolHeater(size_t toolIndex, int8_t heater) { }
+	void SetToolOffset(size_t toolIndex, size_t axisIndex, float offset) { }
+	void SetBedOrChamberHeater(const uint8_t heaterIndex, const int8_t heaterNumber, bool bed) { }
+	void ResetBedsAndChambers() { }
+	void SetSpindleActive(size_t index, uint16_t active) { }
+	void SetSpindleCurrent(size_t index, uint16_t current) { }
+	void SetSpindleMax(size_t index, uint16_t max) { }
+	void SetSpindleTool(int8_t spindle, int8_t toolIndex) { }
+}
+
+// End
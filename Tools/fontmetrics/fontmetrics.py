@@ -0,0 +1,94 @@
+#!/usr/bin/env python3
+#
+# fontmetrics.py
+#
+#  Created on: 16 Oct 2026
+#
+#  Generates the metrics table for a PanelDue font, so that the firmware can measure text without doing a dummy print.
+#  For each character it records the width and the two columns of pixel data that the auto-kerning in UTFT::writeNative looks at,
+#  worked out exactly as writeNative works them out, so that text measured with the table is always the same width as text printed.
+#
+#  Usage: fontmetrics.py ../../src/Fonts/glcd19x21.cpp > ../../src/Fonts/glcd19x21Metrics.cpp
+#  Run it again whenever the font changes.
+
+import os
+import re
+import sys
+
+def read_font(path):
+    with open(path) as f:
+        text = f.read()
+    text = re.sub(r'//[^\n]*', '', text)
+    text = re.sub(r'/\*.*?\*/', '', text, flags=re.S)
+    m = re.search(r'(\w+)\s*\[\s*\]\s*=\s*\{(.*?)\}', text, flags=re.S)
+    if m is None:
+        sys.exit("%s: can't find the font array" % path)
+    values = [int(v, 0) for v in re.findall(r'0[xX][0-9a-fA-F]+|\d+', m.group(2))]
+    return m.group(1), values
+
+def column(data, offset):
+    # writeNative reads 4 bytes at a time whatever the font height, so the column data may include bytes from the next column
+    word = 0
+    for i in range(4):
+        if offset + i < len(data):
+            word |= data[offset + i] << (8 * i)
+    return word
+
+def metrics(values):
+    x_size, y_size, spaces = values[0], values[1], values[2]
+    first_char = values[4] | (values[5] << 8)
+    data = values[8:]
+    bytes_per_column = (y_size + 7) // 8
+    bytes_per_char = bytes_per_column * x_size + 1
+    cmask = (1 << y_size) - 1 if y_size < 32 else 0xFFFFFFFF
+    chars = []
+    for start in range(0, len(data) - bytes_per_char + 1, bytes_per_char):
+        num_cols = data[start]
+        first_column = column(data, start + 1) & cmask
+        if first_column == 0:
+            first_column = column(data, start + 1 + bytes_per_column) & cmask
+        last_column = None
+        for col in range(num_cols):
+            col_data = column(data, start + 1 + col * bytes_per_column)
+            if col_data != 0:
+                last_column = col_data & cmask
+        chars.append((first_column, last_column, num_cols))
+    return first_char, chars
+
+def char_comment(code):
+    if code < 0x7F and chr(code) not in "\\'":
+        return "'%s'" % chr(code)
+    return 'U+%04X' % code
+
+def main():
+    if len(sys.argv) != 2:
+        sys.exit('Usage: fontmetrics.py font.cpp')
+    path = sys.argv[1]
+    name, values = read_font(path)
+    first_char, chars = metrics(values)
+    out = []
+    out.append('/*')
+    out.append(' * %sMetrics.cpp' % name)
+    out.append(' *')
+    out.append(' * Generated by Tools/fontmetrics/fontmetrics.py from %s. Do not edit; run the script again if the font changes.' % os.path.basename(path))
+    out.append(' */')
+    out.append('')
+    out.append('#include "Hardware/UTFT.hpp"')
+    out.append('')
+    out.append('extern const uint8_t %s[];' % name)
+    out.append('')
+    out.append('static const CharMetrics chars[] =')
+    out.append('{')
+    for i, (first_column, last_column, num_cols) in enumerate(chars):
+        blank = last_column is None
+        out.append('\t{ 0x%08X, 0x%08X, %2u, %-5s },\t\t// %s' %
+                   (first_column, 0 if blank else last_column, num_cols, 'true' if blank else 'false', char_comment(first_char + i)))
+    out.append('};')
+    out.append('')
+    out.append('extern const FontMetrics %sMetrics = { %s, chars, sizeof(chars)/sizeof(chars[0]) };' % (name, name))
+    out.append('')
+    out.append('// End')
+    sys.stdout.write('\n'.join(out) + '\n')
+
+if __name__ == '__main__':
+    main()
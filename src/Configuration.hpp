@@ -55,6 +55,7 @@
 #endif
 
 const uint32_t DefaultBaudRate = 115200;
+const uint32_t NegotiatedBaudRates[] = { 57600, 115200, 230400, 250000, 460800, 500000, 921600, 1000000 };	// rates that automatic negotiation tries, lowest first
 const uint32_t DimDisplayTimeout = 60000;				// dim this display after no activity for this number of milliseconds
 const uint32_t DefaultScreensaverTimeout = 120000;		// enable screensaver after no activity for this number of milliseconds
 const uint32_t ScreensaverMoveTime = 10000;				// Jog around screen saver text after this number of milliseconds
@@ -62,7 +63,23 @@ const uint32_t DefaultInfoTimeout = 5;					// information message timeout in sec
 const uint8_t DefaultBabystepAmountIndex = 1;			// default babystep amount of 0.02mm
 const uint16_t DefaultFeedrate = 6000;					// default feedrate in mm/min
 
-const uint32_t MinimumEncoderCommandInterval = 50;		// minimum time in milliseconds between serial commands sent due to encoder movement
+const uint32_t MinimumEncoderCommandInterval = 50;		// how often we read the encoder, and so the minimum time in milliseconds between serial commands sent due to encoder movement
 const uint32_t MaxEncoderCommandLength = 64;			// maximum length of an encoder movement command
 
+// Encoder jog acceleration. While the wheel is turning at least clicksPerSecond, each click moves the axis factor times the jog amount
+// and the feed rate is multiplied by the same factor, up to MaxEncoderJogFeedRate. The entries must be in increasing order of speed.
+struct EncoderJogAcceleration
+{
+	uint16_t clicksPerSecond;
+	uint16_t factor;
+};
+
+const EncoderJogAcceleration EncoderJogAccelerationCurve[] = { { 0, 1 }, { 10, 2 }, { 20, 5 }, { 40, 10 } };
+const uint32_t MaxEncoderJogFeedRate = 24000;			// mm/min
+const size_t MaxEncoderJogMovesInFlight = 2;			// how many encoder jog moves we let the printer have queued
+const uint32_t MaxEncoderJogClicksHeld = 2;				// how many clicks we keep while waiting for the printer to catch up
+const uint32_t EncoderJogMoveOverhead = 30;				// milliseconds added to the estimated time of each jog move for communication and command processing
+const float EncoderJogMachineAcceleration = 500.0;		// mm/s^2, used to estimate how long each jog move takes. Set it no higher than the slowest jogged axis.
+const float MaxEncoderJogDistanceInFlight = 50.0;		// mm, the most we let the printer have queued unless a single click is bigger
+
 #endif /* CONFIGURATION_H_ */
@@ -17,6 +17,24 @@
 
 extern UTFT lcd;
 
+// Find out how wide some text would be when printed in a font, given a function that prints the text to the TextPrinter it is passed.
+// If we have metrics for the font we lay the text out using them, which is much faster than a dummy print and doesn't disturb the display.
+template<class F> static PixelNumber MeasureText(LcdFont font, PixelNumber maxWidth, F printText)
+{
+	const FontMetrics * const metrics = UTFT::GetFontMetrics(font);
+	if (metrics != nullptr)
+	{
+		TextMeasurer measurer(*metrics, std::min<PixelNumber>(maxWidth, lcd.getDisplayXSize()));
+		printText(measurer);
+		return measurer.getTextX();
+	}
+
+	lcd.setFont(font);
+	lcd.setTextPos(0, 9999, maxWidth);
+	printText(lcd);						// dummy print to get text width
+	return lcd.getTextX();
+}
+
 const int maxXerror = 8, maxYerror = 8;		// how close (in pixels) the X and Y coordinates of a touch event need to be to the outline of the button for us to allow it
 
 // Static fields of class DisplayField
@@ -28,11 +46,43 @@ Colour DisplayField::defaultGradColour = 0;
 Colour DisplayField::defaultPressedBackColour = black;
 Colour DisplayField::defaultPressedGradColour = 0;
 Palette DisplayField::defaultIconPalette = IconPaletteLight;
+DisplayField * null DisplayField::changedFields[MaxChangedFields];
+size_t DisplayField::numChangedFields = 0;
+bool DisplayField::changedFieldsOverflowed = false;
 
 DisplayField::DisplayField(PixelNumber py, PixelNumber px, PixelNumber pw)
 	: y(py), x(px), width(pw), fcolour(defaultFcolour), bcolour(defaultBcolour),
-		changed(true), visible(true), underlined(false), border(false), textRows(1), next(nullptr)
+		changed(true), visible(true), underlined(false), border(false), textRows(1), queued(false), displayed(false), next(nullptr)
+{
+}
+
+// Flag the field as needing to be redrawn, and add it to the list of changed fields for the next incremental refresh
+void DisplayField::SetChanged()
+{
+	changed = true;
+	if (!queued)
+	{
+		if (numChangedFields < MaxChangedFields)
+		{
+			changedFields[numChangedFields++] = this;
+			queued = true;
+		}
+		else
+		{
+			changedFieldsOverflowed = true;
+		}
+	}
+}
+
+// Empty the list of changed fields. Fields that are still flagged as changed are redrawn by the next full refresh of the window they are in.
+/*static*/ void DisplayField::ForgetChangedFields()
 {
+	for (size_t i = 0; i < numChangedFields; ++i)
+	{
+		changedFields[i]->queued = false;
+	}
+	numChangedFields = 0;
+	changedFieldsOverflowed = false;
 }
 
 void DisplayField::SetTextRows(const char * _ecv_array null t)
@@ -60,7 +110,7 @@ void DisplayField::SetPositionAndWidth(PixelNumber newX, PixelNumber newWidth)
 	}
 	x = newX;
 	width = newWidth;
-	changed = true;
+	SetChanged();
 }
 
 void DisplayField::SetPosition(PixelNumber x, PixelNumber y)
@@ -71,7 +121,7 @@ void DisplayField::SetPosition(PixelNumber x, PixelNumber y)
 	}
 	this->x = x;
 	this->y = y;
-	changed = true;
+	SetChanged();
 }
 
 /*static*/ void DisplayField::SetDefaultColours(Colour pf, Colour pb, Colour pbb, Colour pg, Colour pbp, Colour pgp, Palette pal)
@@ -87,24 +137,27 @@ void DisplayField::SetPosition(PixelNumber x, PixelNumber y)
 
 /*static*/ PixelNumber DisplayField::GetTextWidth(const char* _ecv_array s, PixelNumber maxWidth)
 {
-	lcd.setFont(DisplayField::defaultFont);
-	lcd.setTextPos(0, 9999, maxWidth);
-	lcd.printf(s);						// dummy print to get text width
-	return lcd.getTextX();
+	return MeasureText(DisplayField::defaultFont, maxWidth, [s](TextPrinter& printer) { printer.printf(s); });
 }
 
 /*static*/ PixelNumber DisplayField::GetTextWidth(const char* _ecv_array s, PixelNumber maxWidth, size_t maxChars)
 {
-	lcd.setTextPos(0, 9999, maxWidth);
-	lcd.printf("%.*s", maxChars, s);				// dummy print to get text width
-	return lcd.getTextX();
+	return MeasureText(DisplayField::defaultFont, maxWidth, [s, maxChars](TextPrinter& printer) { printer.printf("%.*s", maxChars, s); });
 }
 
 void DisplayField::Show(bool v)
 {
 	if (visible != v)
 	{
-		visible = changed = v;
+		visible = v;
+		if (v)
+		{
+			SetChanged();
+		}
+		else
+		{
+			changed = false;
+		}
 	}
 }
 
@@ -127,7 +180,7 @@ void DisplayField::SetColours(Colour pf, Colour pb)
 	{
 		fcolour = pf;
 		bcolour = pb;
-		changed = true;
+		SetChanged();
 	}
 }
 
@@ -183,6 +236,18 @@ void Window::AddField(DisplayField *d)
 	root = d;
 }
 
+bool Window::HasField(const DisplayField *f) const
+{
+	for (const DisplayField * null p = root; p != nullptr; p = p->next)
+	{
+		if (p == f)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
 bool Window::ObscuredByPopup(const DisplayField *p) const
 {
 	return next != nullptr
@@ -225,20 +290,29 @@ void Window::SetPopup(PopupWindow * p, PixelNumber px, PixelNumber py, bool redr
 	{
 		py = (displayY - p->GetHeight())/2;
 	}
-	p->SetPos(px, py);
 	Window *pw = this;
 	while (pw->next != nullptr)
 	{
 		if (pw->next == p)
 		{
+			// The popup is already displayed. If it is moving, redraw what it leaves uncovered.
+			const PixelNumber xmin = p->Xpos(), xmax = xmin + p->GetWidth() - 1, ymin = p->Ypos(), ymax = ymin + p->GetHeight() - 1;
+			p->SetPos(px, py);
 			if (redraw)
 			{
+				if (px != xmin || py != ymin)
+				{
+					pw->next = nullptr;			// detach it while we repair the old area, because we are about to draw it anyway
+					RedrawUncoveredArea(pw, xmin, ymin, xmax, ymax);
+					pw->next = p;
+				}
 				p->Refresh(true);
 			}
-			return;				// popup is already displayed
+			return;
 		}
 		pw = pw->next;
 	}
+	p->SetPos(px, py);
 	p->next = nullptr;			// ensure no nested popup
 	pw->next = p;
 	if (redraw)
@@ -261,39 +335,63 @@ void Window::ClearPopup(bool redraw, PopupWindow *whichOne)
 		if (whichOne == nullptr || whichOne == pw->next)
 		{
 			const PixelNumber xmin = pw->next->Xpos(), xmax = xmin + pw->next->GetWidth() - 1, ymin = pw->next->Ypos(), ymax = ymin + pw->next->GetHeight() - 1;
-			bool popupWasContained = pw->Contains(xmin, ymin, xmax, ymax);
-			if (popupWasContained)
-			{
-				// Clear the area that was occupied by the last window to the background colour of the penultimate window
-				lcd.setColor(pw->backgroundColour);
-				lcd.fillRoundRect(xmin, ymin, xmax, ymax);
-			}
 
 			// Detach the last window
 			pw->next = nullptr;
 
 			if (redraw)
 			{
-				if (popupWasContained)
-				{
-					// Re-display the fields of the penultimate window that were obscured
-					for (DisplayField * null pp = pw->root; pp != nullptr; pp = pp->next)
-					{
-						if (pp->IsVisible())
-						{
-							pp->Refresh(true, pw->Xpos(), pw->Ypos());
-						}
-					}
-				}
-				else
-				{
-					Refresh(true);		// redraw everything
-				}
+				RedrawUncoveredArea(pw, xmin, ymin, xmax, ymax);
 			}
 		}
 	}
 }
 
+// Redraw an area of the screen that a popup or field no longer covers. The coordinates are absolute.
+// We start from the highest window up to and including 'top' that contains the whole area, because the windows below it can't show through.
+void Window::RedrawUncoveredArea(Window *top, PixelNumber xmin, PixelNumber ymin, PixelNumber xmax, PixelNumber ymax)
+{
+	Window *bottom = this;
+	for (Window *pw = this; pw != top; )
+	{
+		pw = pw->next;
+		if (pw->Contains(xmin, ymin, xmax, ymax))
+		{
+			bottom = pw;
+		}
+	}
+	bottom->RedrawArea(xmin, ymin, xmax, ymax);
+}
+
+// Clear an area of this window to the background colour and redraw just the fields and popups that overlap it. The coordinates are absolute.
+// Fields that are partly hidden by a popup are not drawn, as in a full refresh.
+void Window::RedrawArea(PixelNumber xmin, PixelNumber ymin, PixelNumber xmax, PixelNumber ymax)
+{
+	lcd.setColor(backgroundColour);
+	lcd.fillRect(xmin, ymin, xmax, ymax);
+
+	for (DisplayField * null p = root; p != nullptr; p = p->next)
+	{
+		if (   p->GetMaxX() + Xpos() >= xmin && p->GetMinX() + Xpos() <= xmax
+			&& p->GetMaxY() + Ypos() >= ymin && p->GetMinY() + Ypos() <= ymax
+			&& Visible(p)
+		   )
+		{
+			p->Refresh(true, Xpos(), Ypos());
+		}
+	}
+
+	// Refreshing a popup refreshes the popups on top of it too, so we only need to refresh the lowest one that overlaps the area
+	for (PopupWindow * null pw = next; pw != nullptr; pw = pw->GetPopup())
+	{
+		if (pw->Overlaps(xmin, ymin, xmax, ymax))
+		{
+			pw->Refresh(true);
+			break;
+		}
+	}
+}
+
 // Redraw the specified field
 void Window::Redraw(DisplayField *f)
 {
@@ -310,8 +408,7 @@ void Window::Redraw(DisplayField *f)
 				}
 				else
 				{
-					lcd.setColor(backgroundColour);
-					lcd.fillRect(p->GetMinX() + Xpos(), p->GetMinY() + Ypos(), p->GetMaxX() + Xpos(), p->GetMaxY() + Ypos());
+					RedrawArea(p->GetMinX() + Xpos(), p->GetMinY() + Ypos(), p->GetMaxX() + Xpos(), p->GetMaxY() + Ypos());
 				}
 			}
 			return;
@@ -346,8 +443,7 @@ void Window::Show(DisplayField * null f, bool v)
 				}
 				else
 				{
-					lcd.setColor(backgroundColour);
-					lcd.fillRect(f->GetMinX(), f->GetMinY(), f->GetMaxX(), f->GetMaxY());
+					RedrawArea(f->GetMinX() + Xpos(), f->GetMinY() + Ypos(), f->GetMaxX() + Xpos(), f->GetMaxY() + Ypos());
 				}
 				return;
 			}
@@ -383,9 +479,25 @@ void MainWindow::Init(Colour bc)
 	backgroundColour = bc;
 }
 
+// Change the list of fields that we display. The caller must do a full refresh afterwards.
+void MainWindow::SetRoot(DisplayField * null r)
+{
+	for (DisplayField * null pp = root; pp != nullptr; pp = pp->next)
+	{
+		pp->displayed = false;
+	}
+	root = r;
+}
+
 // Refresh all fields. If 'full' is true then we rewrite them all, else we just rewrite those that have changed.
 void MainWindow::Refresh(bool full)
 {
+	if (!full && !DisplayField::changedFieldsOverflowed)
+	{
+		RefreshChangedFields();
+		return;
+	}
+
 	if (full)
 	{
 		lcd.fillScr(backgroundColour, staticLeftMargin);
@@ -393,6 +505,7 @@ void MainWindow::Refresh(bool full)
 
 	for (DisplayField * null pp = root; pp != nullptr; pp = pp->next)
 	{
+		pp->displayed = true;
 		if (Visible(pp))
 		{
 			pp->Refresh(full, 0, 0);
@@ -402,6 +515,45 @@ void MainWindow::Refresh(bool full)
 	{
 		next->Refresh(full);
 	}
+	DisplayField::ForgetChangedFields();
+}
+
+// Redraw just the fields in the list of changed fields, so that when little has changed we don't have to look at every field.
+// A changed field that isn't in our field list or in a popup is left flagged as changed, so that it gets drawn when its page is next displayed.
+void MainWindow::RefreshChangedFields()
+{
+	for (size_t i = 0; i < DisplayField::numChangedFields; ++i)
+	{
+		DisplayField * const f = DisplayField::changedFields[i];
+		f->queued = false;
+		if (!f->HasChanged())
+		{
+			continue;						// it has been redrawn already, e.g. by Show or Redraw
+		}
+
+		const Window *w = nullptr;
+		if (f->displayed)
+		{
+			w = this;
+		}
+		else
+		{
+			for (const PopupWindow * null p = next; p != nullptr; p = p->GetPopup())
+			{
+				if (p->HasField(f))
+				{
+					w = p;
+					break;
+				}
+			}
+		}
+
+		if (w != nullptr && w->Visible(f))
+		{
+			f->Refresh(false, w->Xpos(), w->Ypos());
+		}
+	}
+	DisplayField::numChangedFields = 0;
 }
 
 bool MainWindow::Contains(PixelNumber xmin, PixelNumber ymin, PixelNumber xmax, PixelNumber ymax) const
@@ -471,6 +623,11 @@ bool PopupWindow::Contains(PixelNumber xmin, PixelNumber ymin, PixelNumber xmax,
 	return xPos + 2 <= xmin && yPos + 2 <= ymin && xPos + width >= xmax + 3 && yPos + height >= ymax + 3;
 }
 
+bool PopupWindow::Overlaps(PixelNumber xmin, PixelNumber ymin, PixelNumber xmax, PixelNumber ymax) const
+{
+	return xPos <= xmax && yPos <= ymax && xPos + width > xmin && yPos + height > ymin;
+}
+
 void ColourGradientField::Refresh(bool full, PixelNumber xOffset, PixelNumber yOffset)
 {
 	if (full)
@@ -546,10 +703,8 @@ void FieldWithText::Refresh(bool full, PixelNumber xOffset, PixelNumber yOffset)
 		lcd.setColor(fcolour);
 		lcd.setBackColor(bcolour);
 
-		// Do a dummy print to get the text width. Needed for underlining and for centre- or right-aligned text.
-		lcd.setTextPos(0, 9999, textWidth);
-		PrintText();
-		const PixelNumber actualWidth = lcd.getTextX();
+		// Get the text width. Needed for underlining and for centre- or right-aligned text.
+		const PixelNumber actualWidth = MeasureText(font, textWidth, [this](TextPrinter& printer) { PrintText(printer); });
 		const PixelNumber underlineY = yOffset + UTFT::GetFontHeight(font) + 1;
 		if (underlined)
 		{
@@ -562,7 +717,7 @@ void FieldWithText::Refresh(bool full, PixelNumber xOffset, PixelNumber yOffset)
 		lcd.setTextPos(xOffset, yOffset, xOffset + textWidth);
 		if (align == TextAlignment::Left)
 		{
-			PrintText();
+			PrintText(lcd);
 			lcd.clearToMargin();
 			if (underlined)
 			{
@@ -577,7 +732,7 @@ void FieldWithText::Refresh(bool full, PixelNumber xOffset, PixelNumber yOffset)
 			{
 				const PixelNumber textX = xOffset + spare/2;
 				lcd.setTextPos(textX, yOffset, xOffset + textWidth);
-				PrintText();
+				PrintText(lcd);
 				if (underlined)
 				{
 					lcd.drawLine(textX, underlineY, textX + actualWidth - 1, underlineY);
@@ -596,7 +751,7 @@ void FieldWithText::Refresh(bool full, PixelNumber xOffset, PixelNumber yOffset)
 				}
 				const PixelNumber textX = xOffset + spare;
 				lcd.setTextPos(textX, yOffset, xOffset + textWidth);
-				PrintText();
+				PrintText(lcd);
 				if (underlined)
 				{
 					lcd.drawLine(textX, underlineY, textX + actualWidth, underlineY);
@@ -607,49 +762,49 @@ void FieldWithText::Refresh(bool full, PixelNumber xOffset, PixelNumber yOffset)
 	}
 }
 
-void TextField::PrintText() const
+void TextField::PrintText(TextPrinter& printer) const
 {
 	if (label != nullptr)
 	{
-		lcd.printf(label);
+		printer.printf(label);
 	}
 	if (text != nullptr)
 	{
-		lcd.printf(text);
+		printer.printf(text);
 	}
 }
 
-void FloatField::PrintText() const
+void FloatField::PrintText(TextPrinter& printer) const
 {
 	if (label != nullptr)
 	{
-		lcd.printf(label);
+		printer.printf(label);
 	}
-	lcd.printf("%.*f", numDecimals, val);
+	printer.printf("%.*f", numDecimals, val);
 	if (units != nullptr)
 	{
-		lcd.printf(units);
+		printer.printf(units);
 	}
 }
 
-void IntegerField::PrintText() const
+void IntegerField::PrintText(TextPrinter& printer) const
 {
 	if (label != nullptr)
 	{
-		lcd.printf(label);
+		printer.printf(label);
 	}
-	lcd.printf("%d", val);
+	printer.printf("%d", val);
 	if (units != nullptr)
 	{
-		lcd.printf(units);
+		printer.printf(units);
 	}
 }
 
-void StaticTextField::PrintText() const
+void StaticTextField::PrintText(TextPrinter& printer) const
 {
 	if (text != nullptr)
 	{
-		lcd.printf(text);
+		printer.printf(text);
 	}
 }
 
@@ -711,7 +866,7 @@ void SingleButton::Press(bool p, int index) /*override*/
 	if (p != pressed)
 	{
 		pressed = p;
-		changed = true;
+		SetChanged();
 	}
 }
 
@@ -737,11 +892,10 @@ void ButtonWithText::Refresh(bool full, PixelNumber xOffset, PixelNumber yOffset
 		PixelNumber rowY = y + yOffset + textMargin + 1;
 		do
 		{
-			lcd.setTextPos(0, 9999, width - 6);
-			PrintText(offset);							// dummy print to get text width
-			PixelNumber spare = width - 6 - lcd.getTextX();
+			const PixelNumber textWidth = MeasureText(font, width - 6, [this, offset](TextPrinter& printer) { PrintText(printer, offset); });
+			PixelNumber spare = width - 6 - textWidth;
 			lcd.setTextPos(x + xOffset + 3 + spare/2, rowY, x + xOffset + width - 3);	// text is always centre-aligned
-			offset += PrintText(offset) + 1;
+			offset += PrintText(lcd, offset) + 1;
 			rowY += UTFT::GetFontHeight(font) + 2;
 		} while (--rowsLeft != 0);
 		lcd.setTransparentBackground(false);
@@ -755,10 +909,10 @@ CharButton::CharButton(PixelNumber py, PixelNumber px, PixelNumber pw, char pc,
 	SetEvent(e, (int)pc);
 }
 
-size_t CharButton::PrintText(size_t offset) const
+size_t CharButton::PrintText(TextPrinter& printer, size_t offset) const
 {
 	UNUSED(offset);
-	return lcd.write((char)GetIParam(0));
+	return printer.write((char)GetIParam(0));
 }
 
 TextButton::TextButton(PixelNumber py, PixelNumber px, PixelNumber pw, const char * _ecv_array null pt, event_t e, int param)
@@ -774,11 +928,11 @@ TextButton::TextButton(PixelNumber py, PixelNumber px, PixelNumber pw, const cha
 	SetEvent(e, param);
 }
 
-size_t TextButton::PrintText(size_t offset) const
+size_t TextButton::PrintText(TextPrinter& printer, size_t offset) const
 {
 	if (text != nullptr)
 	{
-		return lcd.printf(text + offset);
+		return printer.printf(text + offset);
 	}
 	return 0;
 }
@@ -793,14 +947,14 @@ TextButtonWithLabel::TextButtonWithLabel(PixelNumber py, PixelNumber px, PixelNu
 {
 }
 
-size_t TextButtonWithLabel::PrintText(size_t offset) const
+size_t TextButtonWithLabel::PrintText(TextPrinter& printer, size_t offset) const
 {
 	size_t w = 0;
 	if (label != nullptr)
 	{
-		w += lcd.printf(label);
+		w += printer.printf(label);
 	}
-	w += TextButton::PrintText(offset);
+	w += TextButton::PrintText(printer, offset);
 	return w;
 }
 
@@ -849,7 +1003,7 @@ IconButtonWithText::IconButtonWithText(PixelNumber py, PixelNumber px, PixelNumb
 {
 }
 
-size_t IconButtonWithText::PrintText() const
+size_t IconButtonWithText::PrintText(TextPrinter& printer) const
 {
 	size_t ret = 0;
 	if (!printText)
@@ -858,10 +1012,10 @@ size_t IconButtonWithText::PrintText() const
 	}
 	if (text != nullptr)
 	{
-		ret += lcd.printf(text);
+		ret += printer.printf(text);
 	}
 	else {
-		ret += lcd.printf("%d", val);
+		ret += printer.printf("%d", val);
 	}
 	return ret;
 }
@@ -875,9 +1029,7 @@ void IconButtonWithText::Refresh(bool full, PixelNumber xOffset, PixelNumber yOf
 						sy = drawIcon ? GetIconHeight(icon) : 0;
 
 		lcd.setFont(font);
-		lcd.setTextPos(0, 9999, width - 6);
-		PrintText();							// dummy print to get text width
-		const PixelNumber textWidth = lcd.getTextX() + 6;	// add three pixels on each side
+		const PixelNumber textWidth = MeasureText(font, width - 6, [this](TextPrinter& printer) { PrintText(printer); }) + 6;	// add three pixels on each side
 
 		// Print the icon
 		lcd.setTransparentBackground(true);
@@ -892,36 +1044,36 @@ void IconButtonWithText::Refresh(bool full, PixelNumber xOffset, PixelNumber yOf
 		const PixelNumber rowY = y + yOffset + textMargin + 1;
 		lcd.setTextPos(textX, rowY, textX + textWidth);
 		lcd.setColor(fcolour);
-		PrintText();
+		PrintText(lcd);
 		lcd.setTransparentBackground(false);
 
 		changed = false;
 	}
 }
 
-size_t IntegerButton::PrintText(size_t offset) const
+size_t IntegerButton::PrintText(TextPrinter& printer, size_t offset) const
 {
 	UNUSED(offset);
 	size_t ret = 0;
 	if (label != nullptr)
 	{
-		ret += lcd.printf(label);
+		ret += printer.printf(label);
 	}
-	ret += lcd.printf("%d", val);
+	ret += printer.printf("%d", val);
 	if (units != nullptr)
 	{
-		ret += lcd.printf(units);
+		ret += printer.printf(units);
 	}
 	return ret;
 }
 
-size_t FloatButton::PrintText(size_t offset) const
+size_t FloatButton::PrintText(TextPrinter& printer, size_t offset) const
 {
 	UNUSED(offset);
-	size_t ret = lcd.printf("%.*f", numDecimals, val);
+	size_t ret = printer.printf("%.*f", numDecimals, val);
 	if (units != nullptr)
 	{
-		ret += lcd.printf(units);
+		ret += printer.printf(units);
 	}
 	return ret;
 }
@@ -957,20 +1109,19 @@ void ButtonRowWithText::Refresh(bool full, PixelNumber xOffset, PixelNumber yOff
 			lcd.setTransparentBackground(true);
 			lcd.setColor(fcolour);
 			lcd.setFont(font);
-			lcd.setTextPos(0, 9999, width - 6);
-			PrintText(i);							// dummy print to get text width
-			PixelNumber spare = width - 6 - lcd.getTextX();
+			const PixelNumber textWidth = MeasureText(font, width - 6, [this, i](TextPrinter& printer) { PrintText(printer, i); });
+			PixelNumber spare = width - 6 - textWidth;
 			lcd.setTextPos(x + buttonXoffset + 3 + spare/2, y + yOffset + textMargin + 1, x + buttonXoffset + width - 3);	// text is always centre-aligned
-			PrintText(i);
+			PrintText(lcd, i);
 			lcd.setTransparentBackground(false);
 		}
 		changed = false;
 	}
 }
 
-void CharButtonRow::PrintText(unsigned int n) const
+void CharButtonRow::PrintText(TextPrinter& printer, unsigned int n) const
 {
-	lcd.write(text[n]);
+	printer.write(text[n]);
 }
 
 CharButtonRow::CharButtonRow(PixelNumber py, PixelNumber px, PixelNumber pw, PixelNumber ps, const char * _ecv_array s, event_t e)
@@ -1018,7 +1169,7 @@ void CharButtonRow::ChangeText(const char* _ecv_array s)
 		return;
 	}
 	text = s;
-	changed = true;
+	SetChanged();
 }
 
 void ProgressBar::Refresh(bool full, PixelNumber xOffset, PixelNumber yOffset)
@@ -87,13 +87,23 @@ protected:
 			visible : 1,
 			underlined : 1,						// really belongs in class FieldWithText, but stored here to save space
 			border : 1,							// really belongs in class FieldWithText, but stored here to save space
-			textRows : 2;						// really belongs in class FieldWithText, but stored here to save space
+			textRows : 2,						// really belongs in class FieldWithText, but stored here to save space
+			queued : 1,							// true if the field is in the list of changed fields
+			displayed : 1;						// true if the field is in the main window's field list and has been drawn by a full refresh
 
 	static LcdFont defaultFont;
 	static Colour defaultFcolour, defaultBcolour;
 	static Colour defaultButtonBorderColour, defaultGradColour, defaultPressedBackColour, defaultPressedGradColour;
 	static Palette defaultIconPalette;
 
+	// The fields that have changed since the last refresh, so that an incremental refresh needn't look at the others
+	static const size_t MaxChangedFields = 64;
+	static DisplayField * null changedFields[MaxChangedFields];
+	static size_t numChangedFields;
+	static bool changedFieldsOverflowed;		// true if some changed fields didn't fit in the list
+
+	friend class MainWindow;
+
 protected:
 	DisplayField(PixelNumber py, PixelNumber px, PixelNumber pw);
 
@@ -109,7 +119,7 @@ public:
 	void Show(bool v);
 	virtual void Refresh(bool full, PixelNumber xOffset, PixelNumber yOffset) = 0;
 	void SetColours(Colour pf, Colour pb);
-	void SetChanged() { changed = true; }
+	void SetChanged();
 	bool HasChanged() const { return changed; }
 	PixelNumber GetMinX() const { return x; }
 	PixelNumber GetMaxX() const { return x + width - 1; }
@@ -125,6 +135,7 @@ public:
 	static void SetDefaultColours(Colour pf, Colour pb, Colour pbb, Colour pg, Colour pbp, Colour pgp, Palette pal);
 	static void SetDefaultFont(LcdFont pf) { defaultFont = pf; }
 	static ButtonPress FindEvent(PixelNumber x, PixelNumber y, DisplayField * null p);
+	static void ForgetChangedFields();
 
 	// Icon management
 	static PixelNumber GetIconWidth(Icon ic) { return ic[0]; }
@@ -152,6 +163,7 @@ public:
 	ButtonPress FindEvent(PixelNumber x, PixelNumber y);
 	ButtonPress FindEventOutsidePopup(PixelNumber x, PixelNumber y);
 	DisplayField * null GetRoot() const { return root; }
+	bool HasField(const DisplayField *f) const;
 	virtual void Refresh(bool full) = 0;
 	void Redraw(DisplayField *f);
 	void Show(DisplayField * null f, bool v);
@@ -164,6 +176,10 @@ public:
 	bool ObscuredByPopup(const DisplayField *p) const;
 	bool Visible(const DisplayField *p) const;
 	virtual bool Contains(PixelNumber xmin, PixelNumber ymin, PixelNumber xmax, PixelNumber ymax) const = 0;
+
+protected:
+	void RedrawUncoveredArea(Window *top, PixelNumber xmin, PixelNumber ymin, PixelNumber xmax, PixelNumber ymax);
+	void RedrawArea(PixelNumber xmin, PixelNumber ymin, PixelNumber xmax, PixelNumber ymax);
 };
 
 class MainWindow : public Window
@@ -174,10 +190,13 @@ public:
 	MainWindow();
 	void Init(Colour pb);
 	void Refresh(bool full) override;
-	void SetRoot(DisplayField * null r) { root = r; }
+	void SetRoot(DisplayField * null r);
 	bool Contains(PixelNumber xmin, PixelNumber ymin, PixelNumber xmax, PixelNumber ymax) const override;
 	void ClearAllPopups();
 	void SetLeftMargin(PixelNumber m) { staticLeftMargin = m; }
+
+private:
+	void RefreshChangedFields();
 };
 
 class PopupWindow : public Window
@@ -197,6 +216,7 @@ public:
 	void Refresh(bool full) override;
 	void SetPos(PixelNumber px, PixelNumber py) { xPos = px; yPos = py; }
 	bool Contains(PixelNumber xmin, PixelNumber ymin, PixelNumber xmax, PixelNumber ymax) const override;
+	bool Overlaps(PixelNumber xmin, PixelNumber ymin, PixelNumber xmax, PixelNumber ymax) const;
 };
 
 class ColourGradientField : public DisplayField
@@ -224,7 +244,7 @@ class FieldWithText : public DisplayField
 protected:
 	PixelNumber GetHeight() const override;
 
-	virtual void PrintText() const = 0;
+	virtual void PrintText(TextPrinter& printer) const = 0;
 
 	FieldWithText(PixelNumber py, PixelNumber px, PixelNumber pw, TextAlignment pa, bool withBorder, bool isUnderlined = false)
 		: DisplayField(py, px, pw), font(DisplayField::defaultFont), align(pa)
@@ -245,7 +265,7 @@ class TextField : public FieldWithText
 	const char* _ecv_array null text;
 
 protected:
-	void PrintText() const override;
+	void PrintText(TextPrinter& printer) const override;
 
 public:
 	TextField(PixelNumber py, PixelNumber px, PixelNumber pw, TextAlignment pa,
@@ -257,13 +277,13 @@ public:
 	void SetValue(const char* _ecv_array s)
 	{
 		text = s;
-		changed = true;
+		SetChanged();
 	}
 
 	void SetLabel(const char* _ecv_array s)
 	{
 		label = s;
-		changed = true;
+		SetChanged();
 	}
 };
 
@@ -276,7 +296,7 @@ class FloatField : public FieldWithText
 	uint8_t numDecimals;
 
 protected:
-	void PrintText() const override;
+	void PrintText(TextPrinter& printer) const override;
 
 public:
 	FloatField(PixelNumber py, PixelNumber px, PixelNumber pw, TextAlignment pa, uint8_t pd,
@@ -294,7 +314,7 @@ public:
 			return;
 		}
 		val = v;
-		changed = true;
+		SetChanged();
 	}
 
 	void SetLabel(const char* _ecv_array s)
@@ -304,7 +324,7 @@ public:
 			return;
 		}
 		label = s;
-		changed = true;
+		SetChanged();
 	}
 };
 
@@ -316,7 +336,7 @@ class IntegerField : public FieldWithText
 	int val;
 
 protected:
-	void PrintText() const override;
+	void PrintText(TextPrinter& printer) const override;
 
 public:
 	IntegerField(PixelNumber py, PixelNumber px, PixelNumber pw, TextAlignment pa,
@@ -332,7 +352,7 @@ public:
 			return;
 		}
 		val = v;
-		changed = true;
+		SetChanged();
 	}
 };
 
@@ -342,7 +362,7 @@ class StaticTextField : public FieldWithText
 	const char * _ecv_array null text;
 
 protected:
-	void PrintText() const override;
+	void PrintText(TextPrinter& printer) const override;
 
 public:
 	StaticTextField(PixelNumber py, PixelNumber px, PixelNumber pw, TextAlignment pa, const char * _ecv_array null pt, bool isUnderlined = false)
@@ -360,7 +380,7 @@ public:
 		}
 		text = pt;
 		SetTextRows(pt);
-		changed = true;
+		SetChanged();
 	}
 };
 
@@ -427,7 +447,7 @@ class ButtonWithText : public SingleButton
 protected:
 	PixelNumber GetHeight() const override;
 
-	virtual size_t PrintText(size_t offset) const = 0;
+	virtual size_t PrintText(TextPrinter& printer, size_t offset) const = 0;
 
 public:
 	ButtonWithText(PixelNumber py, PixelNumber px, PixelNumber pw)
@@ -442,7 +462,7 @@ public:
 class CharButton : public ButtonWithText
 {
 protected:
-	size_t PrintText(size_t offset) const override;
+	size_t PrintText(TextPrinter& printer, size_t offset) const override;
 
 public:
 	CharButton(PixelNumber py, PixelNumber px, PixelNumber pw, char pc, event_t e);
@@ -466,7 +486,7 @@ class ButtonRowWithText : public ButtonRow
 
 protected:
 	PixelNumber GetHeight() const override;
-	virtual void PrintText(unsigned int n) const = 0;
+	virtual void PrintText(TextPrinter& printer, unsigned int n) const = 0;
 
 public:
 	ButtonRowWithText(PixelNumber py, PixelNumber px, PixelNumber pw, PixelNumber ps, unsigned int nb, event_t e);
@@ -482,7 +502,7 @@ class CharButtonRow : public ButtonRowWithText
 	const char * _ecv_array text;
 
 protected:
-	void PrintText(unsigned int n) const override;
+	void PrintText(TextPrinter& printer, unsigned int n) const override;
 	void CheckEvent(PixelNumber x, PixelNumber y, int& bestError, ButtonPress& best) override;
 
 public:
@@ -500,7 +520,7 @@ class TextButton : public ButtonWithText
 	const char * _ecv_array null text;
 
 protected:
-	size_t PrintText(size_t offset) const override;
+	size_t PrintText(TextPrinter& printer, size_t offset) const override;
 
 public:
 	TextButton(PixelNumber py, PixelNumber px, PixelNumber pw, const char * _ecv_array null pt, event_t e, int param = 0);
@@ -516,7 +536,7 @@ public:
 			return;
 		}
 		text = pt;
-		changed = true;
+		SetChanged();
 	}
 };
 
@@ -524,7 +544,7 @@ class TextButtonWithLabel : public TextButton
 {
 	const char * _ecv_array null label;
 protected:
-	size_t PrintText(size_t offset) const override;
+	size_t PrintText(TextPrinter& printer, size_t offset) const override;
 public:
 	TextButtonWithLabel(PixelNumber py, PixelNumber px, PixelNumber pw, const char * _ecv_array null pt, event_t e, int param = 0, const char* _ecv_array null label = nullptr);
 	TextButtonWithLabel(PixelNumber py, PixelNumber px, PixelNumber pw, const char * _ecv_array null pt, event_t e, const char * _ecv_array param, const char* _ecv_array null label = nullptr);
@@ -539,7 +559,7 @@ public:
 			return;
 		}
 		this->label = label;
-		changed = true;
+		SetChanged();
 	}
 };
 
@@ -582,7 +602,7 @@ class IconButtonWithText : public IconButton
 	bool drawIcon;
 
 protected:
-	size_t PrintText() const;
+	size_t PrintText(TextPrinter& printer) const;
 
 public:
 	IconButtonWithText(PixelNumber py, PixelNumber px, PixelNumber pw, Icon ic, event_t e, const char * text, int param = 0);
@@ -599,7 +619,7 @@ public:
 			return;
 		}
 		icon = newIcon;
-		changed = true;
+		SetChanged();
 	}
 
 	void SetText(const char * t)
@@ -609,7 +629,7 @@ public:
 			return;
 		}
 		text = t;
-		changed = true;
+		SetChanged();
 	}
 
 	void SetIntVal(int newVal)
@@ -619,19 +639,25 @@ public:
 			return;
 		}
 		val = newVal;
-		changed = true;
+		SetChanged();
 	}
 
 	void SetPrintText(const bool pt)
 	{
-		changed = pt != printText;
-		printText = pt;
+		if (pt != printText)
+		{
+			printText = pt;
+			SetChanged();
+		}
 	}
 
 	void SetDrawIcon(const bool di)
 	{
-		changed = di != drawIcon;
-		drawIcon = di;
+		if (di != drawIcon)
+		{
+			drawIcon = di;
+			SetChanged();
+		}
 	}
 };
 
@@ -643,7 +669,7 @@ class IntegerButton : public ButtonWithText
 	int val;
 
 protected:
-	size_t PrintText(size_t offset) const override;
+	size_t PrintText(TextPrinter& printer, size_t offset) const override;
 
 public:
 	IntegerButton(PixelNumber py, PixelNumber px, PixelNumber pw, const char * _ecv_array pl = nullptr, const char * _ecv_array pt = nullptr)
@@ -658,13 +684,13 @@ public:
 			return;
 		}
 		val = pv;
-		changed = true;
+		SetChanged();
 	}
 
 	void Increment(int amount)
 	{
 		val += amount;
-		changed = true;
+		SetChanged();
 	}
 };
 
@@ -676,7 +702,7 @@ class FloatButton : public ButtonWithText
 	uint8_t numDecimals;
 
 protected:
-	size_t PrintText(size_t offset) const override;
+	size_t PrintText(TextPrinter& printer, size_t offset) const override;
 
 public:
 	FloatButton(PixelNumber py, PixelNumber px, PixelNumber pw, uint8_t pd, const char * _ecv_array pt = nullptr)
@@ -692,13 +718,13 @@ public:
 			return;
 		}
 		val = pv;
-		changed = true;
+		SetChanged();
 	}
 
 	void Increment(int amount)
 	{
 		val += amount;
-		changed = true;
+		SetChanged();
 	}
 };
 
@@ -725,7 +751,7 @@ public:
 			return;
 		}
 		percent = pc;
-		changed = true;
+		SetChanged();
 	}
 };
 
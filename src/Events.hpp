@@ -62,6 +62,7 @@ enum Event : uint8_t
 	evPrintFile,
 	evSendCommand,
 	evFactoryReset,
+	evLinkDiagnostics, evRefreshLinkDiagnostics, evMoreLinkDiagnostics, evSendLinkReport,
 	evAdjustSpeed,
 	evPAdjustExtrusionPercent, // TODO: remove as soon as we have extruder number
 
@@ -0,0 +1,369 @@
+/*
+ * glcd19x21Metrics.cpp
+ *
+ * Generated by Tools/fontmetrics/fontmetrics.py from glcd19x21.cpp. Do not edit; run the script again if the font changes.
+ */
+
+#include "Hardware/UTFT.hpp"
+
+extern const uint8_t glcd19x21[];
+
+static const CharMetrics chars[] =
+{
+	{ 0x00000000, 0x00000000,  7, true  },		// ' '
+	{ 0x00019FF8, 0x00019FF8,  2, false },		// '!'
+	{ 0x000000F8, 0x000000F8,  5, false },		// '"'
+	{ 0x00001000, 0x00000080, 12, false },		// '#'
+	{ 0x00002000, 0x00003000, 12, false },		// '$'
+	{ 0x000003F0, 0x0000FC00, 17, false },		// '%'
+	{ 0x0000F800, 0x00010000, 13, false },		// '&'
+	{ 0x000000F8, 0x000000F8,  2, false },		// U+0027
+	{ 0x00003E00, 0x0018000C,  5, false },		// '('
+	{ 0x0018000C, 0x00003E00,  6, false },		// ')'
+	{ 0x00000020, 0x00000020,  6, false },		// '*'
+	{ 0x00000200, 0x00000200, 10, false },		// '+'
+	{ 0x00098000, 0x00078000,  2, false },		// ','
+	{ 0x00001800, 0x00001800,  5, false },		// '-'
+	{ 0x00018000, 0x00018000,  2, false },		// '.'
+	{ 0x00018000, 0x0000000C,  6, false },		// '/'
+	{ 0x00003FC0, 0x00003FC0, 10, false },		// '0'
+	{ 0x00010060, 0x00010000,  9, false },		// '1'
+	{ 0x00018040, 0x000100C0, 10, false },		// '2'
+	{ 0x00006060, 0x00007860, 10, false },		// '3'
+	{ 0x00001000, 0x00001000, 11, false },		// '4'
+	{ 0x00006380, 0x00007C00, 10, false },		// '5'
+	{ 0x00001F80, 0x00007C00, 10, false },		// '6'
+	{ 0x00000008, 0x00000018, 10, false },		// '7'
+	{ 0x000078E0, 0x000078E0, 10, false },		// '8'
+	{ 0x000043E0, 0x00001FC0, 10, false },		// '9'
+	{ 0x000180C0, 0x000180C0,  2, false },		// ':'
+	{ 0x000980C0, 0x000780C0,  2, false },		// ';'
+	{ 0x00000700, 0x00006030, 10, false },		// '<'
+	{ 0x00001080, 0x00001080, 10, false },		// '='
+	{ 0x00006030, 0x00000700, 10, false },		// '>'
+	{ 0x00000060, 0x000001E0, 10, false },		// '?'
+	{ 0x0000FF00, 0x00001FC0, 17, false },		// '@'
+	{ 0x00010000, 0x00010000, 13, false },		// 'A'
+	{ 0x0001FFF8, 0x00007800, 11, false },		// 'B'
+	{ 0x00001F80, 0x00006060, 13, false },		// 'C'
+	{ 0x0001FFF8, 0x00001F80, 12, false },		// 'D'
+	{ 0x0001FFF8, 0x00010008, 11, false },		// 'E'
+	{ 0x0001FFF8, 0x00000408, 10, false },		// 'F'
+	{ 0x00001F80, 0x00007C60, 13, false },		// 'G'
+	{ 0x0001FFF8, 0x0001FFF8, 10, false },		// 'H'
+	{ 0x0001FFF8, 0x0001FFF8,  2, false },		// 'I'
+	{ 0x00002000, 0x00007FF8,  9, false },		// 'J'
+	{ 0x0001FFF8, 0x00010000, 11, false },		// 'K'
+	{ 0x0001FFF8, 0x00010000,  9, false },		// 'L'
+	{ 0x0001FFF8, 0x0001FFF8, 13, false },		// 'M'
+	{ 0x0001FFF8, 0x0001FFF8, 10, false },		// 'N'
+	{ 0x00001F80, 0x00001F80, 14, false },		// 'O'
+	{ 0x0001FFF8, 0x000001E0, 11, false },		// 'P'
+	{ 0x00001F80, 0x00001F80, 14, false },		// 'Q'
+	{ 0x0001FFF8, 0x00010000, 12, false },		// 'R'
+	{ 0x00006000, 0x00007800, 12, false },		// 'S'
+	{ 0x00000008, 0x00000008, 12, false },		// 'T'
+	{ 0x00000FF8, 0x00000FF8, 12, false },		// 'U'
+	{ 0x00000008, 0x00000008, 13, false },		// 'V'
+	{ 0x00000078, 0x00000078, 19, false },		// 'W'
+	{ 0x00010008, 0x00010008, 12, false },		// 'X'
+	{ 0x00000018, 0x00000018, 12, false },		// 'Y'
+	{ 0x00018008, 0x00010008, 11, false },		// 'Z'
+	{ 0x001FFFFC, 0x00100004,  4, false },		// '['
+	{ 0x0000000C, 0x00018000,  6, false },		// U+005C
+	{ 0x00100004, 0x001FFFFC,  4, false },		// ']'
+	{ 0x00000400, 0x00000400,  8, false },		// '^'
+	{ 0x00100000, 0x00100000, 12, false },		// '_'
+	{ 0x00000004, 0x00000010,  4, false },		// '`'
+	{ 0x0000F100, 0x00010000, 11, false },		// 'a'
+	{ 0x0001FFFC, 0x00007F00,  9, false },		// 'b'
+	{ 0x00003E00, 0x0000C180,  9, false },		// 'c'
+	{ 0x00007F00, 0x0001FFFC,  9, false },		// 'd'
+	{ 0x00003F00, 0x00004E00, 10, false },		// 'e'
+	{ 0x00000040, 0x00000044,  6, false },		// 'f'
+	{ 0x00047F00, 0x0003FFC0,  9, false },		// 'g'
+	{ 0x0001FFFC, 0x0001FF00,  9, false },		// 'h'
+	{ 0x0001FFCC, 0x0001FFCC,  2, false },		// 'i'
+	{ 0x00100000, 0x000FFFCC,  3, false },		// 'j'
+	{ 0x0001FFFC, 0x00010000,  9, false },		// 'k'
+	{ 0x0001FFFC, 0x0001FFFC,  2, false },		// 'l'
+	{ 0x0001FFC0, 0x0001FF00, 14, false },		// 'm'
+	{ 0x0001FFC0, 0x0001FF00,  9, false },		// 'n'
+	{ 0x00007F00, 0x00007F00, 10, false },		// 'o'
+	{ 0x001FFFC0, 0x00007F00,  9, false },		// 'p'
+	{ 0x00007F00, 0x001FFFC0,  9, false },		// 'q'
+	{ 0x0001FFC0, 0x000000C0,  6, false },		// 'r'
+	{ 0x0000C380, 0x0000F180,  9, false },		// 's'
+	{ 0x00000040, 0x00010040,  6, false },		// 't'
+	{ 0x00007FC0, 0x0001FFC0,  9, false },		// 'u'
+	{ 0x00000040, 0x00000040, 11, false },		// 'v'
+	{ 0x000000C0, 0x000000C0, 15, false },		// 'w'
+	{ 0x000180C0, 0x000180C0,  8, false },		// 'x'
+	{ 0x00000040, 0x00000040, 11, false },		// 'y'
+	{ 0x00018040, 0x000100C0,  7, false },		// 'z'
+	{ 0x00000800, 0x00100004,  7, false },		// '{'
+	{ 0x001FFFFC, 0x001FFFFC,  2, false },		// '|'
+	{ 0x00100004, 0x00000800,  7, false },		// '}'
+	{ 0x00000200, 0x00000200, 10, false },		// '~'
+	{ 0x0000FFFC, 0x0000FFFC,  5, false },		// U+007F
+	{ 0x00000000, 0x00000000,  2, true  },		// U+0080
+	{ 0x00000C00, 0x00000C00, 19, false },		// U+0081
+	{ 0x00000060, 0x00000060, 10, false },		// U+0082
+	{ 0x00000C00, 0x00000C00, 19, false },		// U+0083
+	{ 0x0000C000, 0x0000C000, 10, false },		// U+0084
+	{ 0x000060C0, 0x000060C0, 10, false },		// U+0085
+	{ 0x00030018, 0x00030018, 10, false },		// U+0086
+	{ 0x00000000, 0x00000000,  1, true  },		// U+0087
+	{ 0x00000000, 0x00000000,  1, true  },		// U+0088
+	{ 0x00000000, 0x00000000,  1, true  },		// U+0089
+	{ 0x00000000, 0x00000000,  1, true  },		// U+008A
+	{ 0x00000000, 0x00000000,  1, true  },		// U+008B
+	{ 0x00000000, 0x00000000,  1, true  },		// U+008C
+	{ 0x00000000, 0x00000000,  1, true  },		// U+008D
+	{ 0x00000000, 0x00000000,  1, true  },		// U+008E
+	{ 0x00000000, 0x00000000,  1, true  },		// U+008F
+	{ 0x00000000, 0x00000000,  1, true  },		// U+0090
+	{ 0x00000000, 0x00000000,  1, true  },		// U+0091
+	{ 0x00000000, 0x00000000,  1, true  },		// U+0092
+	{ 0x00000000, 0x00000000,  1, true  },		// U+0093
+	{ 0x00000000, 0x00000000,  1, true  },		// U+0094
+	{ 0x00000000, 0x00000000,  1, true  },		// U+0095
+	{ 0x00000000, 0x00000000,  1, true  },		// U+0096
+	{ 0x00000000, 0x00000000,  1, true  },		// U+0097
+	{ 0x00000000, 0x00000000,  1, true  },		// U+0098
+	{ 0x00000000, 0x00000000,  1, true  },		// U+0099
+	{ 0x00000000, 0x00000000,  1, true  },		// U+009A
+	{ 0x00000000, 0x00000000,  1, true  },		// U+009B
+	{ 0x00000000, 0x00000000,  1, true  },		// U+009C
+	{ 0x00000000, 0x00000000,  1, true  },		// U+009D
+	{ 0x00000000, 0x00000000,  1, true  },		// U+009E
+	{ 0x00000000, 0x00000000,  1, true  },		// U+009F
+	{ 0x00000000, 0x00000000,  1, true  },		// U+00A0
+	{ 0x000FFCC0, 0x000FFCC0,  2, false },		// U+00A1
+	{ 0x00000600, 0x000038C0,  9, false },		// U+00A2
+	{ 0x00018200, 0x00004000, 11, false },		// U+00A3
+	{ 0x00000400, 0x00000E00, 10, false },		// U+00A4
+	{ 0x00000008, 0x00000008, 12, false },		// U+00A5
+	{ 0x001FE3FC, 0x001FE3FC,  2, false },		// U+00A6
+	{ 0x00010000, 0x00018610, 10, false },		// U+00A7
+	{ 0x0000000C, 0x0000000C,  6, false },		// U+00A8
+	{ 0x00000F00, 0x00000F00, 15, false },		// U+00A9
+	{ 0x00000380, 0x00000400,  7, false },		// U+00AA
+	{ 0x00001C00, 0x00008080, 10, false },		// U+00AB
+	{ 0x00000200, 0x00007E00, 10, false },		// U+00AC
+	{ 0x00001800, 0x00001800,  5, false },		// U+00AD
+	{ 0x00000F00, 0x00000F00, 15, false },		// U+00AE
+	{ 0x00000002, 0x00000002, 12, false },		// U+00AF
+	{ 0x00000060, 0x00000060,  6, false },		// U+00B0
+	{ 0x00010200, 0x00010200, 10, false },		// U+00B1
+	{ 0x00000800, 0x000008F0,  6, false },		// U+00B2
+	{ 0x00000C10, 0x00000770,  5, false },		// U+00B3
+	{ 0x00000010, 0x00000004,  4, false },		// U+00B4
+	{ 0x001FFFC0, 0x00010000, 10, false },		// U+00B5
+	{ 0x000001F0, 0x00000008,  9, false },		// U+00B6
+	{ 0x00000600, 0x00000600,  2, false },		// U+00B7
+	{ 0x00060000, 0x00180000,  3, false },		// U+00B8
+	{ 0x00000810, 0x00000800,  6, false },		// U+00B9
+	{ 0x000001E0, 0x000001E0,  8, false },		// U+00BA
+	{ 0x00008080, 0x00001C00, 10, false },		// U+00BB
+	{ 0x00000810, 0x00004000, 16, false },		// U+00BC
+	{ 0x00000810, 0x00010000, 16, false },		// U+00BD
+	{ 0x00000C10, 0x00004000, 16, false },		// U+00BE
+	{ 0x00018000, 0x00030000, 10, false },		// U+00BF
+	{ 0x00010000, 0x00010000, 13, false },		// U+00C0
+	{ 0x00010000, 0x00010000, 13, false },		// U+00C1
+	{ 0x00010000, 0x00010000, 13, false },		// U+00C2
+	{ 0x00010000, 0x00010000, 13, false },		// U+00C3
+	{ 0x00010000, 0x00010000, 13, false },		// U+00C4
+	{ 0x00010000, 0x00010000, 13, false },		// U+00C5
+	{ 0x00018000, 0x00010008, 19, false },		// U+00C6
+	{ 0x00001F80, 0x00006060, 13, false },		// U+00C7
+	{ 0x0001FFF8, 0x00010008, 11, false },		// U+00C8
+	{ 0x0001FFF8, 0x00010008, 11, false },		// U+00C9
+	{ 0x0001FFF8, 0x00010008, 11, false },		// U+00CA
+	{ 0x0001FFF8, 0x00010008, 11, false },		// U+00CB
+	{ 0x00000001, 0x0001FFFA,  3, false },		// U+00CC
+	{ 0x0001FFFA, 0x00000001,  3, false },		// U+00CD
+	{ 0x00000002, 0x00000002,  5, false },		// U+00CE
+	{ 0x00000003, 0x00000003,  7, false },		// U+00CF
+	{ 0x00000200, 0x00001F80, 14, false },		// U+00D0
+	{ 0x0001FFF8, 0x0001FFF8, 10, false },		// U+00D1
+	{ 0x00001F80, 0x00001F80, 14, false },		// U+00D2
+	{ 0x00001F80, 0x00001F80, 14, false },		// U+00D3
+	{ 0x00001F80, 0x00001F80, 14, false },		// U+00D4
+	{ 0x00001F80, 0x00001F80, 14, false },		// U+00D5
+	{ 0x00001F80, 0x00001F80, 14, false },		// U+00D6
+	{ 0x00003060, 0x00003060,  8, false },		// U+00D7
+	{ 0x00011F80, 0x00001F88, 14, false },		// U+00D8
+	{ 0x00000FF8, 0x00000FF8, 12, false },		// U+00D9
+	{ 0x00000FF8, 0x00000FF8, 12, false },		// U+00DA
+	{ 0x00000FF8, 0x00000FF8, 12, false },		// U+00DB
+	{ 0x00000FF8, 0x00000FF8, 12, false },		// U+00DC
+	{ 0x00000018, 0x00000018, 12, false },		// U+00DD
+	{ 0x0001FFF8, 0x00000780, 11, false },		// U+00DE
+	{ 0x0001FFC0, 0x0000F000, 11, false },		// U+00DF
+	{ 0x0000F100, 0x00010000, 11, false },		// U+00E0
+	{ 0x0000F100, 0x00010000, 11, false },		// U+00E1
+	{ 0x0000F100, 0x00010000, 11, false },		// U+00E2
+	{ 0x0000F100, 0x00010000, 11, false },		// U+00E3
+	{ 0x0000F100, 0x00010000, 11, false },		// U+00E4
+	{ 0x0000F100, 0x00010000, 11, false },		// U+00E5
+	{ 0x0000F900, 0x00004E00, 17, false },		// U+00E6
+	{ 0x00003E00, 0x0000C180,  9, false },		// U+00E7
+	{ 0x00003F00, 0x00004E00, 10, false },		// U+00E8
+	{ 0x00003F00, 0x00004E00, 10, false },		// U+00E9
+	{ 0x00003F00, 0x00004E00, 10, false },		// U+00EA
+	{ 0x00003F00, 0x00004E00, 10, false },		// U+00EB
+	{ 0x00000004, 0x0001FFD0,  4, false },		// U+00EC
+	{ 0x0001FFD0, 0x00000004,  4, false },		// U+00ED
+	{ 0x00000010, 0x00000010,  7, false },		// U+00EE
+	{ 0x0000000C, 0x0000000C,  6, false },		// U+00EF
+	{ 0x00007E00, 0x00007F00, 10, false },		// U+00F0
+	{ 0x0001FFC0, 0x0001FF00,  9, false },		// U+00F1
+	{ 0x00007F00, 0x00007F00, 10, false },		// U+00F2
+	{ 0x00007F00, 0x00007F00, 10, false },		// U+00F3
+	{ 0x00007F00, 0x00007F00, 10, false },		// U+00F4
+	{ 0x00007F00, 0x00007F00, 10, false },		// U+00F5
+	{ 0x00007F00, 0x00007F00, 10, false },		// U+00F6
+	{ 0x00000200, 0x00000200, 10, false },		// U+00F7
+	{ 0x00011C00, 0x00001C40, 10, false },		// U+00F8
+	{ 0x00007FC0, 0x0001FFC0,  9, false },		// U+00F9
+	{ 0x00007FC0, 0x0001FFC0,  9, false },		// U+00FA
+	{ 0x00007FC0, 0x0001FFC0,  9, false },		// U+00FB
+	{ 0x00007FC0, 0x0001FFC0,  9, false },		// U+00FC
+	{ 0x00000040, 0x00000040, 11, false },		// U+00FD
+	{ 0x001FFFFC, 0x00007F00, 10, false },		// U+00FE
+	{ 0x00000040, 0x00000040, 11, false },		// U+00FF
+	{ 0x00010000, 0x00010000, 13, false },		// U+0100
+	{ 0x0000F200, 0x00010000, 10, false },		// U+0101
+	{ 0x00010000, 0x00010000, 13, false },		// U+0102
+	{ 0x0000F200, 0x00010000, 10, false },		// U+0103
+	{ 0x00010000, 0x00110000, 13, false },		// U+0104
+	{ 0x0000F200, 0x00110000, 10, false },		// U+0105
+	{ 0x00001F00, 0x000060C0, 13, false },		// U+0106
+	{ 0x00007E00, 0x0000C300,  9, false },		// U+0107
+	{ 0x00001F00, 0x000060C0, 13, false },		// U+0108
+	{ 0x00007E00, 0x0000C320,  9, false },		// U+0109
+	{ 0x00001F00, 0x000060C0, 13, false },		// U+010A
+	{ 0x00007E00, 0x0000C300,  9, false },		// U+010B
+	{ 0x00001F00, 0x000060C0, 13, false },		// U+010C
+	{ 0x00007E00, 0x0000C308,  9, false },		// U+010D
+	{ 0x00000000, 0x00001F80, 13, false },		// U+010E
+	{ 0x00007E00, 0x00000038, 13, false },		// U+010F
+	{ 0x00000400, 0x00001F80, 13, false },		// U+0110
+	{ 0x00007E00, 0x00000020, 11, false },		// U+0111
+	{ 0x00000000, 0x00010010, 12, false },		// U+0112
+	{ 0x00007E00, 0x00004E00, 10, false },		// U+0113
+	{ 0x00000000, 0x00010010, 12, false },		// U+0114
+	{ 0x00007E00, 0x00004E00, 10, false },		// U+0115
+	{ 0x00000000, 0x00010010, 12, false },		// U+0116
+	{ 0x00007E00, 0x00004E00, 10, false },		// U+0117
+	{ 0x00000000, 0x00110010, 12, false },		// U+0118
+	{ 0x00007E00, 0x00004E00, 10, false },		// U+0119
+	{ 0x00000000, 0x00010010, 12, false },		// U+011A
+	{ 0x00007E00, 0x00004E00, 10, false },		// U+011B
+	{ 0x00001F80, 0x00007C00, 14, false },		// U+011C
+	{ 0x00047E00, 0x0003FF80, 10, false },		// U+011D
+	{ 0x00001F80, 0x00007C00, 14, false },		// U+011E
+	{ 0x00047E00, 0x0003FF80, 10, false },		// U+011F
+	{ 0x00001F80, 0x00007C00, 14, false },		// U+0120
+	{ 0x00047E00, 0x0003FF80, 10, false },		// U+0121
+	{ 0x00001F80, 0x00007C00, 14, false },		// U+0122
+	{ 0x00047E00, 0x0003FF80, 10, false },		// U+0123
+	{ 0x0001FFF0, 0x0001FFF0, 12, false },		// U+0124
+	{ 0x0001FFF8, 0x0001FF00,  9, false },		// U+0125
+	{ 0x00000040, 0x00000040, 13, false },		// U+0126
+	{ 0x00000010, 0x0001FF00,  9, false },		// U+0127
+	{ 0x00000006, 0x00000006,  6, false },		// U+0128
+	{ 0x00000030, 0x00000030,  6, false },		// U+0129
+	{ 0x00000004, 0x00000004,  5, false },		// U+012A
+	{ 0x00000020, 0x00000020,  5, false },		// U+012B
+	{ 0x00000003, 0x00000003,  6, false },		// U+012C
+	{ 0x00000018, 0x00000018,  6, false },		// U+012D
+	{ 0x00000000, 0x00100000,  5, false },		// U+012E
+	{ 0x001FFF98, 0x00100000,  4, false },		// U+012F
+	{ 0x00000000, 0x0001FFF6,  4, false },		// U+0130
+	{ 0x00000000, 0x0001FF80,  4, false },		// U+0131
+	{ 0x00000000, 0x00001FF0, 13, false },		// U+0132
+	{ 0x0001FF98, 0x000FFF98,  7, false },		// U+0133
+	{ 0x00002000, 0x00001FF4,  9, false },		// U+0134
+	{ 0x00100030, 0x00000020,  5, false },		// U+0135
+	{ 0x00000000, 0x00010010, 12, false },		// U+0136
+	{ 0x0001FFF8, 0x00010000,  9, false },		// U+0137
+	{ 0x0001FF80, 0x00010000, 10, false },		// U+0138
+	{ 0x00000000, 0x00010000, 10, false },		// U+0139
+	{ 0x0001FFFA, 0x00000001,  4, false },		// U+013A
+	{ 0x00000000, 0x00010000, 10, false },		// U+013B
+	{ 0x0015FFF8, 0x000DFFF8,  3, false },		// U+013C
+	{ 0x00000000, 0x00010000, 10, false },		// U+013D
+	{ 0x0001FFF8, 0x00000038,  6, false },		// U+013E
+	{ 0x00000000, 0x00010000, 10, false },		// U+013F
+	{ 0x0001FFF8, 0x00000600,  6, false },		// U+0140
+	{ 0x00001800, 0x00010000, 10, false },		// U+0141
+	{ 0x00001800, 0x00000600,  4, false },		// U+0142
+	{ 0x0001FFF0, 0x0001FFF0, 12, false },		// U+0143
+	{ 0x0001FF80, 0x0001FF00,  9, false },		// U+0144
+	{ 0x0001FFF0, 0x0001FFF0, 12, false },		// U+0145
+	{ 0x0001FF80, 0x0001FF00,  9, false },		// U+0146
+	{ 0x0001FFF0, 0x0001FFF0, 12, false },		// U+0147
+	{ 0x0001FF80, 0x0001FF00,  9, false },		// U+0148
+	{ 0x000000B0, 0x0001FF00, 10, false },		// U+0149
+	{ 0x00000000, 0x00003F80, 13, false },		// U+014A
+	{ 0x0001FF80, 0x000FFE00, 10, false },		// U+014B
+	{ 0x00003F80, 0x00001F80, 14, false },		// U+014C
+	{ 0x00007E00, 0x00007E00, 10, false },		// U+014D
+	{ 0x00003F80, 0x00001F80, 14, false },		// U+014E
+	{ 0x00007E00, 0x00007E00, 10, false },		// U+014F
+	{ 0x00003F80, 0x00001F80, 14, false },		// U+0150
+	{ 0x00007E00, 0x00007E08, 10, false },		// U+0151
+	{ 0x00003F80, 0x00010010, 18, false },		// U+0152
+	{ 0x00007E00, 0x00004E00, 17, false },		// U+0153
+	{ 0x00000000, 0x00010080, 13, false },		// U+0154
+	{ 0x0001FF80, 0x00000188,  6, false },		// U+0155
+	{ 0x00000000, 0x00010080, 13, false },		// U+0156
+	{ 0x0015FF80, 0x00000180,  6, false },		// U+0157
+	{ 0x00000000, 0x00010080, 13, false },		// U+0158
+	{ 0x0001FF88, 0x00000008,  7, false },		// U+0159
+	{ 0x00004000, 0x00007040, 12, false },		// U+015A
+	{ 0x0000C700, 0x0000F300,  9, false },		// U+015B
+	{ 0x00004000, 0x00007040, 12, false },		// U+015C
+	{ 0x0000C700, 0x0000F300,  9, false },		// U+015D
+	{ 0x00004000, 0x00007040, 12, false },		// U+015E
+	{ 0x0000C700, 0x0000F300,  9, false },		// U+015F
+	{ 0x00004000, 0x00007040, 12, false },		// U+0160
+	{ 0x0000C700, 0x0000F300,  9, false },		// U+0161
+	{ 0x00000010, 0x00000010, 12, false },		// U+0162
+	{ 0x00000080, 0x001D0080,  5, false },		// U+0163
+	{ 0x00000010, 0x00000010, 12, false },		// U+0164
+	{ 0x00000080, 0x00000038,  7, false },		// U+0165
+	{ 0x00000010, 0x00000010, 12, false },		// U+0166
+	{ 0x00000880, 0x00010880,  5, false },		// U+0167
+	{ 0x00001FF0, 0x00001FF0, 12, false },		// U+0168
+	{ 0x0000FF80, 0x0001FF80,  9, false },		// U+0169
+	{ 0x00001FF0, 0x00001FF0, 12, false },		// U+016A
+	{ 0x0000FF80, 0x0001FF80,  9, false },		// U+016B
+	{ 0x00001FF0, 0x00001FF0, 12, false },		// U+016C
+	{ 0x0000FF80, 0x0001FF80,  9, false },		// U+016D
+	{ 0x00001FF0, 0x00001FF0, 12, false },		// U+016E
+	{ 0x0000FF80, 0x0001FF80,  9, false },		// U+016F
+	{ 0x00001FF0, 0x00001FF0, 12, false },		// U+0170
+	{ 0x0000FF80, 0x00000008, 10, false },		// U+0171
+	{ 0x00001FF0, 0x00001FF0, 12, false },		// U+0172
+	{ 0x0000FF80, 0x0011FF80,  9, false },		// U+0173
+	{ 0x00000010, 0x00000010, 19, false },		// U+0174
+	{ 0x00000180, 0x00000180, 13, false },		// U+0175
+	{ 0x00000030, 0x00000030, 11, false },		// U+0176
+	{ 0x00000080, 0x00000080,  9, false },		// U+0177
+	{ 0x00000030, 0x00000030, 11, false },		// U+0178
+	{ 0x00018010, 0x00010010, 11, false },		// U+0179
+	{ 0x00018080, 0x00010180,  8, false },		// U+017A
+	{ 0x00018010, 0x00010010, 11, false },		// U+017B
+	{ 0x00018080, 0x00010180,  8, false },		// U+017C
+	{ 0x00018010, 0x00010010, 11, false },		// U+017D
+	{ 0x00018080, 0x00010188,  8, false },		// U+017E
+	{ 0x0001FFF0, 0x00000008,  5, false },		// U+017F
+};
+
+extern const FontMetrics glcd19x21Metrics = { glcd19x21, chars, sizeof(chars)/sizeof(chars[0]) };
+
+// End
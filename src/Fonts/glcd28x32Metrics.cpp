@@ -0,0 +1,369 @@
+/*
+ * glcd28x32Metrics.cpp
+ *
+ * Generated by Tools/fontmetrics/fontmetrics.py from glcd28x32.cpp. Do not edit; run the script again if the font changes.
+ */
+
+#include "Hardware/UTFT.hpp"
+
+extern const uint8_t glcd28x32[];
+
+static const CharMetrics chars[] =
+{
+	{ 0x00000000, 0x00000000, 11, true  },		// ' '
+	{ 0x038FFFC0, 0x03807FC0,  3, false },		// '!'
+	{ 0x00000FC0, 0x00000FC0,  8, false },		// '"'
+	{ 0x00180000, 0x00001800, 16, false },		// '#'
+	{ 0x00200000, 0x00100000, 16, false },		// '$'
+	{ 0x00007E00, 0x007E0000, 24, false },		// '%'
+	{ 0x007C0000, 0x03000000, 18, false },		// '&'
+	{ 0x00000FC0, 0x00000FC0,  2, false },		// U+0027
+	{ 0x00FFE000, 0xC0000060,  7, false },		// '('
+	{ 0xC0000060, 0x00FFE000,  7, false },		// ')'
+	{ 0x00000400, 0x00000400, 11, false },		// '*'
+	{ 0x00018000, 0x00018000, 15, false },		// '+'
+	{ 0x33800000, 0x3F800000,  2, false },		// ','
+	{ 0x00060000, 0x00060000,  8, false },		// '-'
+	{ 0x03800000, 0x03800000,  2, false },		// '.'
+	{ 0x03000000, 0x00000060,  8, false },		// '/'
+	{ 0x000FF000, 0x000FF000, 14, false },		// '0'
+	{ 0x03000000, 0x03000000, 13, false },		// '1'
+	{ 0x03000000, 0x03000000, 14, false },		// '2'
+	{ 0x00200000, 0x00380000, 14, false },		// '3'
+	{ 0x001C0000, 0x00180000, 14, false },		// '4'
+	{ 0x00200000, 0x003E0000, 14, false },		// '5'
+	{ 0x003FFC00, 0x001E0000, 13, false },		// '6'
+	{ 0x000000C0, 0x000000C0, 14, false },		// '7'
+	{ 0x00380000, 0x00380000, 14, false },		// '8'
+	{ 0x00003800, 0x0003E000, 14, false },		// '9'
+	{ 0x03801C00, 0x03801C00,  2, false },		// ':'
+	{ 0x33801C00, 0x3F801C00,  2, false },		// ';'
+	{ 0x00038000, 0x00C00600, 15, false },		// '<'
+	{ 0x00183000, 0x00183000, 15, false },		// '='
+	{ 0x00C00600, 0x00038000, 15, false },		// '>'
+	{ 0x00000C00, 0x00001E00, 14, false },		// '?'
+	{ 0x003F0000, 0x00018000, 25, false },		// '@'
+	{ 0x02000000, 0x02000000, 19, false },		// 'A'
+	{ 0x03FFFFC0, 0x007E0000, 15, false },		// 'B'
+	{ 0x00018000, 0x00200000, 19, false },		// 'C'
+	{ 0x03FFFFC0, 0x0003C000, 18, false },		// 'D'
+	{ 0x03FFFFC0, 0x03000000, 16, false },		// 'E'
+	{ 0x03FFFFC0, 0x000000C0, 15, false },		// 'F'
+	{ 0x00018000, 0x007F0000, 20, false },		// 'G'
+	{ 0x03FFFFC0, 0x03FFFFC0, 17, false },		// 'H'
+	{ 0x03FFFFC0, 0x03FFFFC0,  3, false },		// 'I'
+	{ 0x00100000, 0x003FFFC0, 13, false },		// 'J'
+	{ 0x03FFFFC0, 0x02000000, 16, false },		// 'K'
+	{ 0x03FFFFC0, 0x03000000, 13, false },		// 'L'
+	{ 0x03FFFFC0, 0x03FFFFC0, 19, false },		// 'M'
+	{ 0x03FFFFC0, 0x03FFFFC0, 17, false },		// 'N'
+	{ 0x0003C000, 0x0001C000, 21, false },		// 'O'
+	{ 0x03FFFFC0, 0x00007F00, 15, false },		// 'P'
+	{ 0x0003C000, 0x0001C000, 21, false },		// 'Q'
+	{ 0x03FFFFC0, 0x03003C00, 17, false },		// 'R'
+	{ 0x00200000, 0x00380000, 17, false },		// 'S'
+	{ 0x000000C0, 0x000000C0, 17, false },		// 'T'
+	{ 0x001FFFC0, 0x001FFFC0, 17, false },		// 'U'
+	{ 0x00000040, 0x00000040, 19, false },		// 'V'
+	{ 0x000003C0, 0x000003C0, 28, false },		// 'W'
+	{ 0x02000000, 0x02000000, 17, false },		// 'X'
+	{ 0x00000040, 0x00000040, 17, false },		// 'Y'
+	{ 0x03800000, 0x03000000, 16, false },		// 'Z'
+	{ 0xFFFFFFE0, 0xC0000060,  6, false },		// '['
+	{ 0x00000060, 0x03000000,  8, false },		// U+005C
+	{ 0xC0000060, 0xFFFFFFE0,  6, false },		// ']'
+	{ 0x00008000, 0x00008000, 14, false },		// '^'
+	{ 0xC0000000, 0xC0000000, 16, false },		// '_'
+	{ 0x00000020, 0x00000100,  6, false },		// '`'
+	{ 0x00780000, 0x03000000, 15, false },		// 'a'
+	{ 0x03FFFFE0, 0x001F8000, 13, false },		// 'b'
+	{ 0x001F8000, 0x00606000, 13, false },		// 'c'
+	{ 0x001F8000, 0x03FFFFE0, 13, false },		// 'd'
+	{ 0x001F8000, 0x00070000, 14, false },		// 'e'
+	{ 0x00000C00, 0x00000C60,  8, false },		// 'f'
+	{ 0x001F8000, 0x1FFFFC00, 13, false },		// 'g'
+	{ 0x03FFFFE0, 0x03FFF000, 12, false },		// 'h'
+	{ 0x03FFFC60, 0x03FFFC60,  3, false },		// 'i'
+	{ 0xC0000000, 0x1FFFFC60,  5, false },		// 'j'
+	{ 0x03FFFFE0, 0x02000000, 12, false },		// 'k'
+	{ 0x03FFFFE0, 0x03FFFFE0,  3, false },		// 'l'
+	{ 0x03FFFC00, 0x03FFF000, 21, false },		// 'm'
+	{ 0x03FFFC00, 0x03FFF000, 12, false },		// 'n'
+	{ 0x001F8000, 0x001F8000, 14, false },		// 'o'
+	{ 0xFFFFFC00, 0x001F8000, 13, false },		// 'p'
+	{ 0x001F8000, 0xFFFFFC00, 13, false },		// 'q'
+	{ 0x03FFFC00, 0x00000C00,  8, false },		// 'r'
+	{ 0x00C04000, 0x00702000, 13, false },		// 's'
+	{ 0x00000C00, 0x03000C00,  8, false },		// 't'
+	{ 0x00FFFC00, 0x03FFFC00, 12, false },		// 'u'
+	{ 0x00000400, 0x00000400, 13, false },		// 'v'
+	{ 0x00000C00, 0x00000C00, 21, false },		// 'w'
+	{ 0x03000C00, 0x03000C00, 11, false },		// 'x'
+	{ 0x00000400, 0x00000400, 13, false },		// 'y'
+	{ 0x03000000, 0x03000000, 12, false },		// 'z'
+	{ 0x00060000, 0xC0000060,  9, false },		// '{'
+	{ 0xFFFFFFE0, 0xFFFFFFE0,  2, false },		// '|'
+	{ 0xC0000060, 0x00060000,  9, false },		// '}'
+	{ 0x00038000, 0x0001C000, 15, false },		// '~'
+	{ 0x01FFFF80, 0x01FFFF80,  5, false },		// U+007F
+	{ 0x00000000, 0x00000000,  3, true  },		// U+0080
+	{ 0x00030000, 0x00030000, 26, false },		// U+0081
+	{ 0x00000180, 0x00000180, 12, false },		// U+0082
+	{ 0x00030000, 0x00030000, 26, false },		// U+0083
+	{ 0x01800000, 0x01800000, 12, false },		// U+0084
+	{ 0x00800100, 0x00800100, 14, false },		// U+0085
+	{ 0x01000080, 0x01000080, 14, false },		// U+0086
+	{ 0x00000000, 0x00000000,  1, true  },		// U+0087
+	{ 0x00000000, 0x00000000,  1, true  },		// U+0088
+	{ 0x00000000, 0x00000000,  1, true  },		// U+0089
+	{ 0x00000000, 0x00000000,  1, true  },		// U+008A
+	{ 0x00000000, 0x00000000,  1, true  },		// U+008B
+	{ 0x00000000, 0x00000000,  1, true  },		// U+008C
+	{ 0x00000000, 0x00000000,  1, true  },		// U+008D
+	{ 0x00000000, 0x00000000,  1, true  },		// U+008E
+	{ 0x00000000, 0x00000000,  1, true  },		// U+008F
+	{ 0x00000000, 0x00000000,  1, true  },		// U+0090
+	{ 0x00000000, 0x00000000,  1, true  },		// U+0091
+	{ 0x00000000, 0x00000000,  1, true  },		// U+0092
+	{ 0x00000000, 0x00000000,  1, true  },		// U+0093
+	{ 0x00000000, 0x00000000,  1, true  },		// U+0094
+	{ 0x00000000, 0x00000000,  1, true  },		// U+0095
+	{ 0x00000000, 0x00000000,  1, true  },		// U+0096
+	{ 0x00000000, 0x00000000,  1, true  },		// U+0097
+	{ 0x00000000, 0x00000000,  1, true  },		// U+0098
+	{ 0x00000000, 0x00000000,  1, true  },		// U+0099
+	{ 0x00000000, 0x00000000,  1, true  },		// U+009A
+	{ 0x00000000, 0x00000000,  1, true  },		// U+009B
+	{ 0x00000000, 0x00000000,  1, true  },		// U+009C
+	{ 0x00000000, 0x00000000,  1, true  },		// U+009D
+	{ 0x00000000, 0x00000000,  1, true  },		// U+009E
+	{ 0x00000000, 0x00000000,  1, true  },		// U+009F
+	{ 0x00000000, 0x00000000,  1, true  },		// U+00A0
+	{ 0x7FFE1C00, 0x7FFF1C00,  3, false },		// U+00A1
+	{ 0x000FF000, 0x00381800, 12, false },		// U+00A2
+	{ 0x03018000, 0x00E00000, 14, false },		// U+00A3
+	{ 0x0037EC00, 0x0037EC00, 12, false },		// U+00A4
+	{ 0x00000040, 0x00000040, 16, false },		// U+00A5
+	{ 0xFFE0FFE0, 0xFFE0FFE0,  2, false },		// U+00A6
+	{ 0x03038300, 0x03E7C180, 12, false },		// U+00A7
+	{ 0x00000180, 0x00000180,  8, false },		// U+00A8
+	{ 0x00018000, 0x00018000, 21, false },		// U+00A9
+	{ 0x00006000, 0x00010000, 11, false },		// U+00AA
+	{ 0x00040000, 0x00802000, 14, false },		// U+00AB
+	{ 0x00018000, 0x007F8000, 15, false },		// U+00AC
+	{ 0x00060000, 0x00060000,  8, false },		// U+00AD
+	{ 0x00018000, 0x00018000, 21, false },		// U+00AE
+	{ 0x00000018, 0x00000018, 16, false },		// U+00AF
+	{ 0x00000F00, 0x00000F00,  8, false },		// U+00B0
+	{ 0x0300C000, 0x0300C000, 14, false },		// U+00B1
+	{ 0x00030100, 0x00020F80,  8, false },		// U+00B2
+	{ 0x00018180, 0x0001F380,  8, false },		// U+00B3
+	{ 0x00000100, 0x00000020,  6, false },		// U+00B4
+	{ 0xFFFFFC00, 0x03000000, 14, false },		// U+00B5
+	{ 0x00001E00, 0x00000040, 14, false },		// U+00B6
+	{ 0x00070000, 0x00070000,  2, false },		// U+00B7
+	{ 0xC0000000, 0x70000000,  5, false },		// U+00B8
+	{ 0x00020300, 0x00020000,  8, false },		// U+00B9
+	{ 0x00001C00, 0x00001C00, 11, false },		// U+00BA
+	{ 0x00802000, 0x00040000, 14, false },		// U+00BB
+	{ 0x00020300, 0x00400000, 22, false },		// U+00BC
+	{ 0x00020300, 0x020F8000, 22, false },		// U+00BD
+	{ 0x00018180, 0x00400000, 21, false },		// U+00BE
+	{ 0x0FC00000, 0x06000000, 14, false },		// U+00BF
+	{ 0x02000000, 0x02000000, 19, false },		// U+00C0
+	{ 0x02000000, 0x02000000, 19, false },		// U+00C1
+	{ 0x02000000, 0x02000000, 19, false },		// U+00C2
+	{ 0x02000000, 0x02000000, 19, false },		// U+00C3
+	{ 0x02000000, 0x02000000, 19, false },		// U+00C4
+	{ 0x02000000, 0x02000000, 19, false },		// U+00C5
+	{ 0x03000000, 0x03000000, 27, false },		// U+00C6
+	{ 0x00018000, 0x00200000, 19, false },		// U+00C7
+	{ 0x03FFFFC0, 0x03000000, 16, false },		// U+00C8
+	{ 0x03FFFFC0, 0x03000000, 16, false },		// U+00C9
+	{ 0x03FFFFC0, 0x03000000, 16, false },		// U+00CA
+	{ 0x03FFFFC0, 0x03000000, 16, false },		// U+00CB
+	{ 0x00000002, 0x00000008,  6, false },		// U+00CC
+	{ 0x03FFFFC8, 0x00000002,  6, false },		// U+00CD
+	{ 0x0000000C, 0x00000008,  8, false },		// U+00CE
+	{ 0x0000000C, 0x0000000C,  7, false },		// U+00CF
+	{ 0x00018000, 0x0003C000, 20, false },		// U+00D0
+	{ 0x03FFFFC0, 0x03FFFFC0, 17, false },		// U+00D1
+	{ 0x0003C000, 0x0001C000, 21, false },		// U+00D2
+	{ 0x0003C000, 0x0001C000, 21, false },		// U+00D3
+	{ 0x0003C000, 0x0001C000, 21, false },		// U+00D4
+	{ 0x0003C000, 0x0001C000, 21, false },		// U+00D5
+	{ 0x0003C000, 0x0001C000, 21, false },		// U+00D6
+	{ 0x00200800, 0x00200800, 13, false },		// U+00D7
+	{ 0x0003C000, 0x0001C020, 21, false },		// U+00D8
+	{ 0x001FFFC0, 0x001FFFC0, 17, false },		// U+00D9
+	{ 0x001FFFC0, 0x001FFFC0, 17, false },		// U+00DA
+	{ 0x001FFFC0, 0x001FFFC0, 17, false },		// U+00DB
+	{ 0x001FFFC0, 0x001FFFC0, 17, false },		// U+00DC
+	{ 0x00000040, 0x00000040, 17, false },		// U+00DD
+	{ 0x03FFFFC0, 0x0007F000, 15, false },		// U+00DE
+	{ 0x03FFFE00, 0x00700000, 15, false },		// U+00DF
+	{ 0x00780000, 0x03000000, 15, false },		// U+00E0
+	{ 0x00780000, 0x03000000, 15, false },		// U+00E1
+	{ 0x00780000, 0x03000000, 15, false },		// U+00E2
+	{ 0x00780000, 0x03000000, 15, false },		// U+00E3
+	{ 0x00780000, 0x03000000, 15, false },		// U+00E4
+	{ 0x00780000, 0x03000000, 15, false },		// U+00E5
+	{ 0x00F80000, 0x00070000, 24, false },		// U+00E6
+	{ 0x001F8000, 0x00606000, 13, false },		// U+00E7
+	{ 0x001F8000, 0x00070000, 14, false },		// U+00E8
+	{ 0x001F8000, 0x00070000, 14, false },		// U+00E9
+	{ 0x001F8000, 0x00070000, 14, false },		// U+00EA
+	{ 0x001F8000, 0x00070000, 14, false },		// U+00EB
+	{ 0x00000010, 0x00000080,  6, false },		// U+00EC
+	{ 0x00000080, 0x00000010,  6, false },		// U+00ED
+	{ 0x00000080, 0x00000080, 10, false },		// U+00EE
+	{ 0x000000C0, 0x000000C0,  8, false },		// U+00EF
+	{ 0x003F0000, 0x003F8000, 14, false },		// U+00F0
+	{ 0x03FFFC00, 0x03FFF000, 12, false },		// U+00F1
+	{ 0x001F8000, 0x001F8000, 14, false },		// U+00F2
+	{ 0x001F8000, 0x001F8000, 14, false },		// U+00F3
+	{ 0x001F8000, 0x001F8000, 14, false },		// U+00F4
+	{ 0x001F8000, 0x001F8000, 14, false },		// U+00F5
+	{ 0x001F8000, 0x001F8000, 14, false },		// U+00F6
+	{ 0x00018000, 0x00018000, 14, false },		// U+00F7
+	{ 0x02000000, 0x00000400, 16, false },		// U+00F8
+	{ 0x00FFFC00, 0x03FFFC00, 12, false },		// U+00F9
+	{ 0x00FFFC00, 0x03FFFC00, 12, false },		// U+00FA
+	{ 0x00FFFC00, 0x03FFFC00, 12, false },		// U+00FB
+	{ 0x00FFFC00, 0x03FFFC00, 12, false },		// U+00FC
+	{ 0x00000400, 0x00000400, 13, false },		// U+00FD
+	{ 0xFFFFFFE0, 0x001F8000, 13, false },		// U+00FE
+	{ 0x00000400, 0x00000400, 13, false },		// U+00FF
+	{ 0x02000000, 0x02000000, 19, false },		// U+0100
+	{ 0x00F80000, 0x03000000, 15, false },		// U+0101
+	{ 0x02000000, 0x02000000, 19, false },		// U+0102
+	{ 0x00F80000, 0x03000000, 15, false },		// U+0103
+	{ 0x02000000, 0xC2000000, 19, false },		// U+0104
+	{ 0x00F80000, 0xC3000000, 15, false },		// U+0105
+	{ 0x0007F000, 0x00700600, 18, false },		// U+0106
+	{ 0x003FC000, 0x00E07000, 12, false },		// U+0107
+	{ 0x0007F000, 0x00700600, 18, false },		// U+0108
+	{ 0x003FC000, 0x00E07000, 12, false },		// U+0109
+	{ 0x0007F000, 0x00700600, 18, false },		// U+010A
+	{ 0x003FC000, 0x00E07000, 12, false },		// U+010B
+	{ 0x0007F000, 0x00700600, 18, false },		// U+010C
+	{ 0x003FC000, 0x00E07000, 12, false },		// U+010D
+	{ 0x03FFFFC0, 0x003FFC00, 17, false },		// U+010E
+	{ 0x003FC000, 0x00000260, 16, false },		// U+010F
+	{ 0x00018000, 0x003FFC00, 19, false },		// U+0110
+	{ 0x003FC000, 0x03FFFFE0, 14, false },		// U+0111
+	{ 0x03FFFFC0, 0x03000000, 16, false },		// U+0112
+	{ 0x001FC000, 0x00C7F000, 13, false },		// U+0113
+	{ 0x03FFFFC0, 0x03000000, 16, false },		// U+0114
+	{ 0x001FC000, 0x00C7F000, 13, false },		// U+0115
+	{ 0x03FFFFC0, 0x03000000, 16, false },		// U+0116
+	{ 0x001FC000, 0x00C7F000, 13, false },		// U+0117
+	{ 0x03FFFFC0, 0xC3000000, 16, false },		// U+0118
+	{ 0x001FC000, 0x00C7F000, 13, false },		// U+0119
+	{ 0x03FFFFC0, 0x03000000, 16, false },		// U+011A
+	{ 0x001FC000, 0x00C7F000, 13, false },		// U+011B
+	{ 0x0007E000, 0x00FF0600, 19, false },		// U+011C
+	{ 0x003FC000, 0x0FFFFC00, 14, false },		// U+011D
+	{ 0x0007E000, 0x00FF0600, 19, false },		// U+011E
+	{ 0x003FC000, 0x0FFFFC00, 14, false },		// U+011F
+	{ 0x0007E000, 0x00FF0600, 19, false },		// U+0120
+	{ 0x003FC000, 0x0FFFFC00, 14, false },		// U+0121
+	{ 0x0007E000, 0x00FF0600, 19, false },		// U+0122
+	{ 0x003FC000, 0x0FFFFC00, 14, false },		// U+0123
+	{ 0x03FFFFC0, 0x03FFFFC0, 17, false },		// U+0124
+	{ 0x03FFFFE0, 0x03FFF000, 13, false },		// U+0125
+	{ 0x00000600, 0x00000600, 20, false },		// U+0126
+	{ 0x00000180, 0x03FFF000, 15, false },		// U+0127
+	{ 0x0000000C, 0x0000000C,  8, false },		// U+0128
+	{ 0x000000C0, 0x000000C0,  8, false },		// U+0129
+	{ 0x00000006, 0x00000006,  6, false },		// U+012A
+	{ 0x000000C0, 0x000000C0,  6, false },		// U+012B
+	{ 0x00000003, 0x00000007,  8, false },		// U+012C
+	{ 0x00000030, 0x00000070,  8, false },		// U+012D
+	{ 0x70000000, 0xC3FFFFC0,  5, false },		// U+012E
+	{ 0x70000000, 0xC3FFFC60,  5, false },		// U+012F
+	{ 0x03FFFFCC, 0x03FFFFCC,  3, false },		// U+0130
+	{ 0x03FFFC00, 0x03FFFC00,  3, false },		// U+0131
+	{ 0x03FFFFC0, 0x00FFFFC0, 16, false },		// U+0132
+	{ 0x03FFFC60, 0x3FFFFC60,  9, false },		// U+0133
+	{ 0x00200000, 0x007FFFCC, 13, false },		// U+0134
+	{ 0xC0000180, 0x00000180,  7, false },		// U+0135
+	{ 0x03FFFFC0, 0x02000000, 17, false },		// U+0136
+	{ 0x03FFFFE0, 0x02000400, 13, false },		// U+0137
+	{ 0x03FFFC00, 0x02000400, 13, false },		// U+0138
+	{ 0x03FFFFC0, 0x03000000, 13, false },		// U+0139
+	{ 0x03FFFFE4, 0x00000003,  4, false },		// U+013A
+	{ 0x03FFFFC0, 0x03000000, 13, false },		// U+013B
+	{ 0x9BFFFFE0, 0x7BFFFFE0,  3, false },		// U+013C
+	{ 0x03FFFFC0, 0x03000000, 13, false },		// U+013D
+	{ 0x03FFFFE0, 0x000003E0,  6, false },		// U+013E
+	{ 0x03FFFFC0, 0x03000000, 13, false },		// U+013F
+	{ 0x03FFFFE0, 0x00018000,  7, false },		// U+0140
+	{ 0x00070000, 0x03000000, 15, false },		// U+0141
+	{ 0x000C0000, 0x03FFFFE0,  5, false },		// U+0142
+	{ 0x03FFFFC0, 0x03FFFFC0, 17, false },		// U+0143
+	{ 0x03FFFC00, 0x03FFF000, 13, false },		// U+0144
+	{ 0x03FFFFC0, 0x03FFFFC0, 17, false },		// U+0145
+	{ 0x03FFFC00, 0x03FFF000, 13, false },		// U+0146
+	{ 0x03FFFFC0, 0x03FFFFC0, 17, false },		// U+0147
+	{ 0x03FFFC00, 0x03FFF000, 13, false },		// U+0148
+	{ 0x000011C0, 0x03FFF000, 16, false },		// U+0149
+	{ 0x03FFFFC0, 0x00FFFF00, 16, false },		// U+014A
+	{ 0x03FFFC00, 0x3FFFF000, 13, false },		// U+014B
+	{ 0x0007F000, 0x003FFC00, 19, false },		// U+014C
+	{ 0x003FC000, 0x00FFF000, 13, false },		// U+014D
+	{ 0x0007F000, 0x003FFC00, 19, false },		// U+014E
+	{ 0x003FC000, 0x00FFF000, 13, false },		// U+014F
+	{ 0x0007F000, 0x003FFC00, 19, false },		// U+0150
+	{ 0x003FC000, 0x00FFF030, 13, false },		// U+0151
+	{ 0x0007F000, 0x03000000, 27, false },		// U+0152
+	{ 0x003FC000, 0x00C7F000, 24, false },		// U+0153
+	{ 0x03FFFFC0, 0x02000000, 18, false },		// U+0154
+	{ 0x03FFFC00, 0x00000C30,  7, false },		// U+0155
+	{ 0x03FFFFC0, 0x02000000, 18, false },		// U+0156
+	{ 0x9BFFFC00, 0x00000C00,  6, false },		// U+0157
+	{ 0x03FFFFC0, 0x02000000, 18, false },		// U+0158
+	{ 0x00000010, 0x00000C30,  8, false },		// U+0159
+	{ 0x00200000, 0x00FE0700, 16, false },		// U+015A
+	{ 0x00400000, 0x01FC3800, 13, false },		// U+015B
+	{ 0x00200000, 0x00FE0700, 16, false },		// U+015C
+	{ 0x00400000, 0x01FC3800, 13, false },		// U+015D
+	{ 0x00200000, 0x00FE0700, 16, false },		// U+015E
+	{ 0x00400000, 0x01FC3800, 13, false },		// U+015F
+	{ 0x00200000, 0x00FE0700, 16, false },		// U+0160
+	{ 0x00400000, 0x00782000, 14, false },		// U+0161
+	{ 0x000000C0, 0x000000C0, 16, false },		// U+0162
+	{ 0x00000C00, 0x03000C00,  8, false },		// U+0163
+	{ 0x000000C0, 0x000000C0, 16, false },		// U+0164
+	{ 0x00000C00, 0x000003E0, 10, false },		// U+0165
+	{ 0x000000C0, 0x000000C0, 16, false },		// U+0166
+	{ 0x00030C00, 0x03030C00,  8, false },		// U+0167
+	{ 0x001FFFC0, 0x007FFFC0, 16, false },		// U+0168
+	{ 0x00FFFC00, 0x03FFFC00, 13, false },		// U+0169
+	{ 0x001FFFC0, 0x007FFFC0, 16, false },		// U+016A
+	{ 0x00FFFC00, 0x03FFFC00, 13, false },		// U+016B
+	{ 0x001FFFC0, 0x007FFFC0, 16, false },		// U+016C
+	{ 0x00FFFC00, 0x03FFFC00, 13, false },		// U+016D
+	{ 0x001FFFC0, 0x007FFFC0, 16, false },		// U+016E
+	{ 0x00FFFC00, 0x03FFFC00, 13, false },		// U+016F
+	{ 0x001FFFC0, 0x007FFFC0, 16, false },		// U+0170
+	{ 0x00FFFC00, 0x03FFFC30, 13, false },		// U+0171
+	{ 0x001FFFC0, 0x007FFFC0, 16, false },		// U+0172
+	{ 0x00FFFC00, 0x03FFFC00, 13, false },		// U+0173
+	{ 0x000000C0, 0x000007C0, 26, false },		// U+0174
+	{ 0x00000C00, 0x0000FC00, 20, false },		// U+0175
+	{ 0x00000040, 0x000000C0, 18, false },		// U+0176
+	{ 0x00000400, 0x00003C00, 13, false },		// U+0177
+	{ 0x00000040, 0x000000C0, 18, false },		// U+0178
+	{ 0x03800000, 0x03000000, 16, false },		// U+0179
+	{ 0x03800000, 0x03000000, 13, false },		// U+017A
+	{ 0x03800000, 0x03000000, 16, false },		// U+017B
+	{ 0x03800000, 0x03000000, 13, false },		// U+017C
+	{ 0x03800000, 0x03000000, 16, false },		// U+017D
+	{ 0x03800000, 0x03000000, 13, false },		// U+017E
+	{ 0x03FFFF80, 0x00000060,  4, false },		// U+017F
+};
+
+extern const FontMetrics glcd28x32Metrics = { glcd28x32, chars, sizeof(chars)/sizeof(chars[0]) };
+
+// End
@@ -9,6 +9,8 @@
 #include "asf.h"
 #include "General/String.h"
 #include "General/SafeVsnprintf.h"
+#include "Library/PerfectHash.hpp"
+#include "Library/Misc.hpp"
 #include "PanelDue.hpp"
 #define DEBUG (0)
 #if DEBUG
@@ -16,6 +18,8 @@
 #endif
 
 const size_t MaxArrayNesting = 4;
+const size_t MaxIdNesting = 16;
+const uint8_t MaxDecimals = 9;				// so that 10^decimals fits in a uint32_t
 
 #if SAM4S
 # define UARTn	UART0
@@ -50,6 +54,172 @@ namespace SerialIo
 	const char* _ecv_array const trCedilla =		"C\xC7"
 											"c\xE7"																			;
 
+	// Transmit data processing.
+	// Each command line is assembled in a slot and queued when it is complete. The PDC sends one line at a time, and when it has finished
+	// the ISR starts the oldest waiting line of the most urgent class, so an urgent command overtakes the others at the next line boundary.
+	// An emergency stop therefore waits for at most the line that is already on the wire.
+	// The line number and checksum are added when a line is started, so that line numbers go out in sequence whatever order the lines are sent in.
+	const size_t NumLineSlots = 6;
+	const size_t MaxLineLength = 200;				// longest command we send, not counting the line number and checksum
+	const size_t LineNumberSpace = 12;				// room for "N4294967295 "
+	const size_t ChecksumSpace = 5;					// room for "*255\n"
+	const uint32_t MaxBaudRateErrorPermille = 20;	// how far our baud rate may be from the one we want, in parts per thousand
+
+	enum class SlotState : uint8_t
+	{
+		free,
+		composing,			// the main loop is assembling a line in it
+		queued,				// waiting to be sent
+		sending				// the PDC is sending it
+	};
+
+	struct LineSlot
+	{
+		char text[LineNumberSpace + MaxLineLength + ChecksumSpace];	// the command starts at text[LineNumberSpace]
+		size_t length;						// length of the command
+		uint32_t sequence;					// order in which the lines were queued
+		CommandClass cls;
+		uint8_t checksum;					// checksum of the command, not including the line number
+		volatile SlotState state;
+	};
+
+	static LineSlot lineSlots[NumLineSlots];
+	static LineSlot *composing = nullptr;		// the slot holding the line being assembled
+	static LineSlot *sending = nullptr;			// the slot that the PDC is sending
+	static bool discarding = false;				// true if the line being assembled is being thrown away
+	static bool lastLineQueued = false;			// true if the last line we finished assembling was queued for sending
+	static CommandClass lineClass = CommandClass::userAction;
+	static uint32_t nextSequence = 0;
+	static volatile bool txBusy = false;
+	static volatile bool holding = false;		// true if lines queued from holdFrom onwards are not to be started yet
+	static volatile uint32_t holdFrom = 0;
+	static CommandCounters commandCounters[NumCommandClasses];
+	static volatile uint32_t commandsSent[NumCommandClasses];	// counted by the ISR, so kept apart from commandCounters
+	static volatile uint32_t txBytes = 0;						// also counted by the ISR, so kept apart from linkCounters
+	static volatile uint32_t txLines = 0;
+
+	static CommandCounters& CountersFor(CommandClass cls)
+	{
+		return commandCounters[(size_t)cls];
+	}
+
+	// Return true if the line in the slot is being held back by HoldTransmit
+	static bool IsHeld(const LineSlot& slot)
+	{
+		return holding && (int32_t)(slot.sequence - holdFrom) >= 0;
+	}
+
+	// Discard anything still queued for transmission, except lines held back for a baud rate change, and enable the PDC transmit channel
+	static void ResetTransmitter()
+	{
+		uart_disable_interrupt(UARTn, UART_IDR_ENDTX);
+		txBusy = false;
+		sending = nullptr;
+		composing = nullptr;
+		discarding = false;
+		for (LineSlot& slot : lineSlots)
+		{
+			if (slot.state == SlotState::queued)
+			{
+				if (IsHeld(slot))
+				{
+					continue;
+				}
+				++CountersFor(slot.cls).dropped;
+			}
+			slot.state = SlotState::free;
+		}
+		UARTn->UART_PTCR = UART_PTCR_TXTEN;
+	}
+
+	// Receive data processing.
+	// The PDC writes received characters directly into the ring buffer, one block at a time. It holds the current block and the next one,
+	// and the ENDRX interrupt queues the block after that. The UART on these chips has no receiver timeout, so partially-filled blocks
+	// are picked up by reading the PDC receive pointer in CheckInput instead of by flushing them from an interrupt.
+	const size_t rxBufsize = 8192;
+	const size_t rxBlockSize = 512;
+	static_assert(rxBufsize % rxBlockSize == 0, "Receive buffer must hold a whole number of PDC blocks");
+	static volatile char rxBuffer[rxBufsize];
+	static size_t nextOut = 0;
+	static volatile size_t rxNextBlock = 0;			// offset of the next block to give to the PDC
+	static volatile bool rxStalled = false;			// true if the ISR could not queue another block because it still holds unread data
+	static volatile bool rxErrorPending = false;		// true if a UART error occurred at rxErrorPos that CheckInput hasn't dealt with yet
+	static volatile size_t rxErrorPos = 0;				// where the first error that CheckInput hasn't dealt with occurred
+	static volatile size_t rxLastErrorPos = 0;			// where the most recent error occurred, which may be later than rxErrorPos
+	static LinkCounters linkCounters;
+	static volatile uint32_t overrunErrors = 0;			// these are counted by the ISR, so they are kept apart from linkCounters
+	static volatile uint32_t framingErrors = 0;
+
+	// The parser hands string values to the consumer where they lie in the receive buffer, unless they have to be rewritten.
+	// While it is receiving one, sliceStart points to its first character and the buffer from rxPinPos onwards is not given back to the PDC.
+	static volatile char * _ecv_array sliceStart = nullptr;
+	static volatile bool rxPinned = false;
+	static volatile size_t rxPinPos = 0;
+	const size_t MaxSliceLength = rxBufsize/2;			// longer strings are copied so that holding them doesn't stop the PDC receiving
+
+	// Return the offset in rxBuffer that the PDC will write the next received character to
+	static size_t GetReceivePosition()
+	{
+		return (UARTn->UART_RPR - reinterpret_cast<uintptr_t>(rxBuffer)) % rxBufsize;
+	}
+
+	// Return true if we can give the block at rxNextBlock to the PDC without overwriting data that CheckInput has not consumed yet,
+	// or a string value that the parser is still holding. The block must stop short of that point, otherwise a completely full buffer
+	// would look the same as an empty one.
+	static bool CanQueueReceiveBlock()
+	{
+		const size_t keepFrom = (rxPinned) ? rxPinPos : nextOut;
+		return (keepFrom + rxBufsize - rxNextBlock) % rxBufsize > rxBlockSize;
+	}
+
+	// Start holding a string value that begins at p in the receive buffer
+	static void PinSlice(volatile char * _ecv_array p)
+	{
+		sliceStart = p;
+		rxPinPos = p - rxBuffer;
+		rxPinned = true;						// set this last, because the ISR reads rxPinPos when it is true
+	}
+
+	// Stop holding the string value, if there is one
+	static void ReleaseSlice()
+	{
+		rxPinned = false;
+		sliceStart = nullptr;
+	}
+
+	// Give the block at rxNextBlock to the PDC, as the current block if it has run out of space or else as the next one
+	static void QueueReceiveBlock()
+	{
+		const uintptr_t blockAddress = reinterpret_cast<uintptr_t>(&rxBuffer[rxNextBlock]);
+		if (UARTn->UART_RCR == 0)
+		{
+			UARTn->UART_RPR = blockAddress;
+			UARTn->UART_RCR = rxBlockSize;
+		}
+		else
+		{
+			UARTn->UART_RNPR = blockAddress;
+			UARTn->UART_RNCR = rxBlockSize;
+		}
+		rxNextBlock = (rxNextBlock + rxBlockSize) % rxBufsize;
+	}
+
+	// Discard any received data and set up the PDC receive channel with the first two blocks
+	static void ResetReceiver()
+	{
+		uart_disable_interrupt(UARTn, UART_IDR_ENDRX);
+		nextOut = 0;
+		rxNextBlock = 0;
+		rxStalled = false;
+		rxErrorPending = false;
+		ReleaseSlice();
+		UARTn->UART_RCR = 0;
+		UARTn->UART_RNCR = 0;
+		QueueReceiveBlock();
+		QueueReceiveBlock();
+		UARTn->UART_PTCR = UART_PTCR_RXTEN;
+	}
+
 	// Initialize the serial I/O subsystem, or re-initialize it with a new baud rate
 	void Init(uint32_t baudRate)
 	{
@@ -69,75 +239,307 @@ namespace SerialIo
 #else
 		irq_register_handler(UART1_IRQn, 5);
 #endif
-		uart_enable_interrupt(UARTn, UART_IER_RXRDY | UART_IER_OVRE | UART_IER_FRAME);
+		ResetTransmitter();
+		ResetReceiver();
+		uart_enable_interrupt(UARTn, UART_IER_ENDRX | UART_IER_OVRE | UART_IER_FRAME);
+	}
+
+	// Return true if the UART can generate the given baud rate to within MaxBaudRateError.
+	// The UART divides the master clock by 16 times an integer, which uart_init rounds down.
+	bool IsBaudRateAccurate(uint32_t baudRate)
+	{
+		const uint32_t mck = sysclk_get_main_hz()/2;
+		const uint32_t divisor = (baudRate == 0) ? 0 : mck/baudRate/16;
+		if (divisor == 0 || divisor > 0xFFFF)
+		{
+			return false;
+		}
+		const uint32_t actual = mck/(16 * divisor);
+		const uint32_t error = (actual > baudRate) ? actual - baudRate : baudRate - actual;
+		return error * 1000 <= baudRate * MaxBaudRateErrorPermille;
 	}
 
-	uint16_t numChars = 0;
-	uint8_t checksum = 0;
+	// Start the PDC sending the oldest waiting line of the most urgent class, if there is one.
+	// Called from the main loop only when the transmitter is idle, and from the ISR only when it is busy, so the two never race.
+	static void StartTransmit()
+	{
+		LineSlot *next = nullptr;
+		for (LineSlot& slot : lineSlots)
+		{
+			if (   slot.state == SlotState::queued
+				&& !IsHeld(slot)
+				&& (next == nullptr || slot.cls < next->cls || (slot.cls == next->cls && (int32_t)(slot.sequence - next->sequence) < 0))
+			   )
+			{
+				next = &slot;
+			}
+		}
+		if (next == nullptr)
+		{
+			return;
+		}
+
+		char *start = &next->text[LineNumberSpace];
+		char *end = start + next->length;
+		if (next->length != 0)
+		{
+			// Put a dummy line number in front of the command and the checksum after it
+			uint8_t checksum = next->checksum ^ ' ' ^ 'N';
+			*--start = ' ';
+			unsigned int num = lineNumber++;
+			do
+			{
+				*--start = (char)(num % 10 + '0');
+				checksum ^= *start;
+				num /= 10;
+			} while (num != 0);
+			*--start = 'N';
+
+			*end++ = '*';
+			if (checksum >= 100)
+			{
+				*end++ = (char)(checksum/100 + '0');
+			}
+			*end++ = (char)((checksum/10) % 10 + '0');
+			*end++ = (char)(checksum % 10 + '0');
+		}
+		*end++ = '\n';
+		txBytes += end - start;
+		++txLines;
+
+		next->state = SlotState::sending;
+		sending = next;
+		UARTn->UART_TPR = reinterpret_cast<uintptr_t>(start);
+		UARTn->UART_TCR = end - start;			// writing TCR clears ENDTX, so this must be done before we flag the transmitter busy
+		txBusy = true;
+		uart_enable_interrupt(UARTn, UART_IER_ENDTX);
+	}
 
-	// Send a character to the 3D printer.
-	// A typical command string is only about 12 characters long, which at 115200 baud takes just over 1ms to send.
-	// So there is no particular reason to use interrupts, and by so doing so we avoid having to handle buffer full situations.
-	void RawSendChar(char c)
+	// Throw away any lines that are waiting to be sent, other than emergency stops
+	static void DiscardQueuedLines()
 	{
-		while(uart_write(UARTn, c) != 0) { }
+		const irqflags_t flags = cpu_irq_save();		// stop the ISR starting one of them while we look
+		for (LineSlot& slot : lineSlots)
+		{
+			if (slot.state == SlotState::queued && slot.cls != CommandClass::emergency)
+			{
+				slot.state = SlotState::free;
+				++CountersFor(slot.cls).dropped;
+			}
+		}
+		cpu_irq_restore(flags);
 	}
 
-	void SendCharAndChecksum(char c)
+	// Return true if a status poll the same as the one in the given slot is waiting to be sent
+	static bool IsPollQueued(const LineSlot& line)
 	{
-		checksum ^= c;
-		RawSendChar(c);
-		++numChars;
+		for (const LineSlot& slot : lineSlots)
+		{
+			if (   &slot != &line
+				&& slot.state == SlotState::queued
+				&& slot.cls == CommandClass::statusPoll
+				&& slot.length == line.length
+				&& memcmp(&slot.text[LineNumberSpace], &line.text[LineNumberSpace], line.length) == 0
+			   )
+			{
+				return true;
+			}
+		}
+		return false;
 	}
 
-	void SendChar(char c)
-	decrease(numChars == 0)
+	// Get a free slot to assemble a line of the given class in. If they are all in use we wait for the PDC to send a line,
+	// except that a status poll is not worth waiting for so we return null, and an emergency stop makes room by discarding the waiting lines.
+	// While lines are held back we can't wait, because the lines we would be waiting for can't be sent until the main loop releases them.
+	static LineSlot *GetFreeSlot(CommandClass cls)
 	{
-		if (c == '\n')
+		for (;;)
 		{
-			if (numChars != 0)
+			for (LineSlot& slot : lineSlots)
 			{
-				// Send the checksum
-				RawSendChar('*');
-				char digit0 = checksum % 10 + '0';
-				checksum /= 10;
-				char digit1 = checksum % 10 + '0';
-				checksum /= 10;
-				if (checksum != 0)
+				if (slot.state == SlotState::free)
 				{
-					RawSendChar(checksum + '0');
+					return &slot;
 				}
-				RawSendChar(digit1);
-				RawSendChar(digit0);
 			}
-			RawSendChar(c);
-			numChars = 0;
+			if (cls == CommandClass::emergency)
+			{
+				DiscardQueuedLines();
+			}
+			else if (cls == CommandClass::statusPoll || holding)
+			{
+				return nullptr;
+			}
+			if (!txBusy)
+			{
+				StartTransmit();
+			}
 		}
-		else
+	}
+
+	// Queue the line that has just been assembled, and start sending it if the transmitter is idle.
+	// Return false if it was merged with an identical status poll that is still waiting, so it won't get a reply of its own.
+	static bool QueueLine()
+	{
+		CommandCounters& counters = CountersFor(lineClass);
+		if (lineClass == CommandClass::statusPoll && IsPollQueued(*composing))
+		{
+			composing->state = SlotState::free;		// the reply to the one that is waiting will tell us the same thing
+			++counters.merged;
+			return false;
+		}
+		if (lineClass == CommandClass::emergency)
+		{
+			DiscardQueuedLines();					// nothing the user asked for before the emergency stop should happen after it
+		}
+
+		uint8_t checksum = 0;
+		for (const char *p = &composing->text[LineNumberSpace]; p != &composing->text[LineNumberSpace + composing->length]; ++p)
+		{
+			checksum ^= *p;
+		}
+		composing->checksum = checksum;
+		composing->cls = lineClass;
+		composing->sequence = nextSequence++;
+		const irqflags_t flags = cpu_irq_save();	// make sure the ISR sees the whole line when it sees that it is queued
+		composing->state = SlotState::queued;
+		cpu_irq_restore(flags);
+		++counters.queued;
+		if (!txBusy)
+		{
+			StartTransmit();
+		}
+		return true;
+	}
+
+	// Don't start sending any line queued from now on until ReleaseTransmit is called. Lines queued before now are still sent.
+	// This is for changing baud rate: the command that asks the printer to change must go at the old rate, and anything after it at the new one.
+	void HoldTransmit()
+	{
+		holdFrom = nextSequence;
+		holding = true;							// set this last, because the ISR reads holdFrom when it is true
+	}
+
+	void ReleaseTransmit()
+	{
+		holding = false;
+		if (!txBusy)
+		{
+			StartTransmit();
+		}
+	}
+
+	void SetCommandClass(CommandClass cls)
+	{
+		lineClass = cls;
+	}
+
+	const CommandCounters& GetCommandCounters(CommandClass cls)
+	{
+		CommandCounters& counters = CountersFor(cls);
+		counters.sent = commandsSent[(size_t)cls];
+		return counters;
+	}
+
+	// Send characters to the 3D printer.
+	// Characters are collected until the end of the line, then the whole line is queued and the PDC sends it in the background.
+	// The characters between newlines are copied into the line in one go, and the checksum is calculated when the line is queued.
+	// We never send part of a line, because the printer would reject it anyway.
+	static void SendChars(const char * _ecv_array s, size_t len)
+	{
+		while (len != 0)
 		{
-			if (numChars == 0)
+			if (composing == nullptr && !discarding)
+			{
+				composing = GetFreeSlot(lineClass);
+				if (composing == nullptr)
+				{
+					discarding = true;
+				}
+				else
+				{
+					composing->state = SlotState::composing;
+					composing->length = 0;
+				}
+			}
+
+			const char * _ecv_array const newline = static_cast<const char *>(memchr(s, '\n', len));
+			const size_t runLength = (newline == nullptr) ? len : newline - s;
+			if (composing != nullptr)
+			{
+				if (composing->length + runLength <= MaxLineLength)
+				{
+					memcpy(&composing->text[LineNumberSpace + composing->length], s, runLength);
+					composing->length += runLength;
+				}
+				else
+				{
+					// The line is too long to send. Sending the start of it would be worse than not sending it at all.
+					composing->state = SlotState::free;
+					composing = nullptr;
+					discarding = true;
+				}
+			}
+			if (newline == nullptr)
+			{
+				break;
+			}
+
+			if (composing != nullptr)
+			{
+				lastLineQueued = QueueLine();
+			}
+			else
 			{
-				checksum = 0;
-				// Send a dummy line number
-				SendCharAndChecksum('N');
-				Sendf("%d", lineNumber++);			// numChars is no longer zero, so only recurses once
-				SendCharAndChecksum(' ');
+				lastLineQueued = false;
+				++CountersFor(lineClass).dropped;
 			}
-			SendCharAndChecksum(c);
+			composing = nullptr;
+			discarding = false;
+			lineClass = CommandClass::userAction;
+			s = newline + 1;
+			len -= runLength + 1;
 		}
 	}
 
+	bool WasLineQueued()
+	{
+		return lastLineQueued;
+	}
+
+	void SendChar(char c)
+	{
+		SendChars(&c, 1);
+	}
+
+	// Format the text into a buffer first so that it can be added to the line in one go.
+	// Text too long for the buffer is too long to send anyway, but it may include the end of the line, so we pass it on a character at a time.
 	size_t Sendf(const char *fmt, ...) noexcept
 	{
-		va_list vargs;
+		va_list vargs, vargsCopy;
 		va_start(vargs, fmt);
-		return vuprintf([](char c) noexcept -> bool {
-			if (c != 0)
-			{
-				SendChar(c);
-			}
-			return true;
-		}, fmt, vargs);
+		va_copy(vargsCopy, vargs);
+		char buffer[MaxLineLength + 2];
+		(void)SafeVsnprintf(buffer, sizeof(buffer), fmt, vargs);
+		va_end(vargs);
+
+		size_t len = strlen(buffer);
+		if (len + 1 < sizeof(buffer))
+		{
+			SendChars(buffer, len);
+		}
+		else
+		{
+			len = vuprintf([](char c) noexcept -> bool {
+				if (c != 0)
+				{
+					SendChar(c);
+				}
+				return true;
+			}, fmt, vargsCopy);
+		}
+		va_end(vargsCopy);
+		return len;
 	}
 
 	void SendFilename(const char * _ecv_array dir, const char * _ecv_array name)
@@ -157,13 +559,6 @@ namespace SerialIo
 		Sendf("%.3f", f);
 	}
 
-	// Receive data processing
-	const size_t rxBufsize = 8192;
-	static volatile char rxBuffer[rxBufsize];
-	static volatile size_t nextIn = 0;
-	static size_t nextOut = 0;
-	static bool inError = false;
-
 	// Enumeration to represent the json parsing state.
 	// We don't allow nested objects or nested arrays, so we don't need a state stack.
 	// An additional variable elementCount is 0 if we are not in an array, else the number of elements we have found (including the current one)
@@ -181,50 +576,144 @@ namespace SerialIo
 		jsFracVal,			// receiving a fractional value
 		jsEndVal,			// had the end of a string or _ecv_array value, expecting comma or ] or }
 		jsCharsVal,			// receiving an alphanumeric value such as true, false, null
+		jsSkipVal,			// skipping a value that the consumer doesn't want, along with any objects and arrays inside it
+		jsCompactTag1,		// had the first byte of the tag that starts a frame in the compact encoding, expecting the second
+		jsCompactTag2,		// expecting the last byte of the tag
+		jsCompact,			// receiving a frame in the compact encoding, which ParseCompactSpan decodes
 		jsError				// something went wrong
 	};
 
 	JsonState state = jsBegin;
 
-	// fieldId is the name of the field being received. A '^' character indicates the position of an array index, and a ':' character indicates a field separator.
-	String<100> fieldId;
+	// Parse errors by the state that the parser was in when it found them, for diagnostics
+	static uint32_t parseErrorsByState[jsError];
+	static const char * const jsonStateNames[] =
+	{
+		"jsBegin", "jsExpectId", "jsId", "jsHadId", "jsVal", "jsStringVal", "jsStringEscape", "jsIntVal", "jsNegIntVal", "jsFracVal",
+		"jsEndVal", "jsCharsVal", "jsSkipVal", "jsCompactTag1", "jsCompactTag2", "jsCompact"
+	};
+	static_assert(ARRAY_SIZE(jsonStateNames) == jsError, "jsonStateNames doesn't match JsonState");
+
+	// The name of the field being received is a path such as "move:axes^:userPosition". A '^' character indicates the position of an array index,
+	// and a ':' character indicates a field separator. We don't store the path; we keep its hash, which we update as each character arrives.
+	// For each separator in the path we remember the hash before and after it, so that we can go back up a level without rescanning.
+	struct IdLevel
+	{
+		uint32_t hashBefore;
+		uint32_t hashAfter;
+		bool isArray;
+	};
+
+	uint32_t fieldIdHash = StringHashInit;
+	IdLevel idLevels[MaxIdNesting];
+	size_t idDepth = 0;
 	String<300> fieldVal;	// long enough for about 6 lines of message
+	uint32_t numMagnitude;	// numeric values are accumulated as the digits arrive
+	uint8_t numDecimals;
+	bool numNegative;
+	bool numOverflow;		// true if there were too many digits before the decimal point
+	size_t skipDepth;		// the number of objects and arrays we are inside while skipping a value
+	bool skipInString;
+	bool skipEscape;
+	uint32_t utf8CharVal;		// the UTF8 character being decoded in a string value
+	unsigned int utf8BytesLeft;	// the number of UTF8 continuation bytes still to come
 	size_t arrayIndices[MaxArrayNesting];
 	size_t arrayDepth = 0;
 
-	static void RemoveLastId()
+	// Return true if the path is empty
+	static bool AtRoot()
 	{
-#if DEBUG
-		MessageLog::AppendMessage(150, "RemoveLastId: %s, len: %d", fieldId.c_str(), fieldId.strlen());
-#endif
-		size_t index = fieldId.strlen();
-		while (index != 0 && fieldId[index - 1] != '^' && fieldId[index - 1] != ':')
+		return idDepth == 0;
+	}
+
+	// Add a separator to the path, returning true if the path is nested too deeply
+	static bool AddIdSeparator(char c)
+	{
+		if (idDepth == MaxIdNesting)
 		{
-			--index;
+			return true;
 		}
-		fieldId.Truncate(index);
+		IdLevel& level = idLevels[idDepth++];
+		level.hashBefore = fieldIdHash;
+		// A root field may have been removed from the path by TranslateRootFieldId, in which case we don't want a leading separator either
+		level.hashAfter = (fieldIdHash == StringHashInit) ? fieldIdHash : StringHashAdd(fieldIdHash, c);
+		level.isArray = (c == '^');
+		fieldIdHash = level.hashAfter;
+		return false;
+	}
+
+	// Remove the last identifier from the path, leaving the separator before it
+	static void RemoveLastId()
+	{
 #if DEBUG
-		MessageLog::AppendMessage(150, "RemoveLastId: %s, len: %d", fieldId.c_str(), fieldId.strlen());
+		MessageLog::AppendMessage(150, "RemoveLastId: hash: %08x, depth: %d", (unsigned int)fieldIdHash, idDepth);
 #endif
+		fieldIdHash = (idDepth != 0) ? idLevels[idDepth - 1].hashAfter : StringHashInit;
 	}
 
+	// Remove the separator at the end of the path
 	static void RemoveLastIdChar()
 	{
 #if DEBUG
 		MessageLog::AppendMessage("RemoveLastIdChar");
 #endif
-		if (fieldId.strlen() != 0)
+		if (idDepth != 0)
 		{
-			fieldId.Truncate(fieldId.strlen() - 1);
+			--idDepth;
+			fieldIdHash = idLevels[idDepth].hashBefore;
 		}
 	}
 
+	// Return true if the path ends with an array index. We never add identifier characters directly after a '^', so we only need to look at the last separator.
 	static bool InArray()
 	{
 #if DEBUG
 		MessageLog::AppendMessage("InArray");
 #endif
-		return fieldId.strlen() > 0 && fieldId[fieldId.strlen() - 1] == '^';
+		return idDepth != 0 && idLevels[idDepth - 1].isArray;
+	}
+
+	static void StartNumber(bool negative)
+	{
+		numMagnitude = 0;
+		numDecimals = 0;
+		numNegative = negative;
+		numOverflow = false;
+	}
+
+	// Add a digit to the number being received. Digits after the decimal point that don't fit are dropped, which truncates the value very slightly.
+	static void AddDigit(char c, bool afterPoint)
+	{
+		const uint32_t digit = (uint32_t)(c - '0');
+		if (afterPoint && numDecimals == MaxDecimals)
+		{
+			return;
+		}
+		if (numMagnitude <= (UINT32_MAX - digit)/10)
+		{
+			numMagnitude = (numMagnitude * 10) + digit;
+			if (afterPoint)
+			{
+				++numDecimals;
+			}
+		}
+		else if (!afterPoint)
+		{
+			numOverflow = true;
+		}
+	}
+
+	// Pass the value we have received to the consumer
+	static void ProcessValue(ReceivedValue::Kind kind)
+	{
+		ReceivedValue val;
+		val.magnitude = numMagnitude;
+		val.decimals = numDecimals;
+		val.negative = numNegative;
+		val.kind = kind;
+		val.text = (sliceStart != nullptr) ? const_cast<const char* _ecv_array>(sliceStart) : fieldVal.c_str();
+		ProcessReceivedValue(fieldIdHash, val, arrayIndices);
+		fieldVal.Clear();
 	}
 
 	static void ProcessField()
@@ -232,15 +721,25 @@ namespace SerialIo
 #if DEBUG
 		MessageLog::AppendMessage("ProcessField");
 #endif
-		if (state == jsCharsVal)
+		switch (state)
 		{
+		case jsIntVal:
+			ProcessValue((numOverflow) ? ReceivedValue::Kind::floatingPoint : ReceivedValue::Kind::integer);
+			break;
+		case jsFracVal:
+			ProcessValue((numOverflow) ? ReceivedValue::Kind::floatingPoint : ReceivedValue::Kind::fixedPoint);
+			break;
+		case jsCharsVal:
 			if (fieldVal.Equals("null"))
 			{
 				fieldVal.Clear();				// so that we can distinguish null from an empty string
 			}
+			ProcessValue(ReceivedValue::Kind::text);
+			break;
+		default:
+			ProcessValue(ReceivedValue::Kind::text);
+			break;
 		}
-		ProcessReceivedValue(fieldId.GetRef(), fieldVal.c_str(), arrayIndices);
-		fieldVal.Clear();
 	}
 
 	static void EndArray()
@@ -248,7 +747,7 @@ namespace SerialIo
 #if DEBUG
 		MessageLog::AppendMessage("EndArray");
 #endif
-		ProcessArrayEnd(fieldId.c_str(), arrayIndices);
+		ProcessArrayEnd(fieldIdHash, arrayIndices);
 		if (arrayDepth != 0)			// should always be true
 		{
 			--arrayDepth;
@@ -256,207 +755,857 @@ namespace SerialIo
 		}
 	}
 
-	// Look for combining characters in the string value and convert them if possible
-	static void ConvertUnicode()
+	// If the UTF-8 character just added to the string value is a combining diacritical mark that we handle, try to combine it with the previous character
+	static void CombineDiacritic(uint32_t charVal)
 	{
-		unsigned int numContinuationBytesLeft = 0;
-		uint32_t charVal;
-		for (size_t i = 0; i < fieldVal.strlen(); )
+		const char* _ecv_array trtab;
+		switch(charVal)
+		{
+		case 0x0300:	// grave accent
+			trtab = trGrave;
+			break;
+		case 0x0301:	// acute accent
+			trtab = trAcute;
+			break;
+		case 0x0302:	// circumflex
+			trtab = trCircumflex;
+			break;
+		case 0x0303:	// tilde
+			trtab = trTilde;
+			break;
+		case 0x0306:	// breve
+			trtab = trBreve;
+			break;
+		case 0x0308:	// umlaut
+			trtab = trUmlaut;
+			break;
+		case 0x030A:	// small circle
+			trtab = trCircle;
+			break;
+		case 0x030C:	// caron
+			trtab = trCaron;
+			break;
+		case 0x0327:	// cedilla
+			trtab = trCedilla;
+			break;
+		default:
+			return;
+		}
+
+		// The diacritical marks are in the range 03xx so they are encoded as 2 UTF8 bytes, which are the last 2 bytes of the string
+		const size_t len = fieldVal.strlen();
+		if (len > 2)
 		{
-			const unsigned char c = fieldVal[i++];
-			if (numContinuationBytesLeft == 0)
+			const char c2 = fieldVal[len - 3];
+			while (*trtab != 0 && *trtab != c2)
+			{
+				trtab += 2;
+			}
+			if (*trtab != 0)
 			{
-				if (c >= 0x80)
+				// Get the translated character and encode it as 2 UTF8 bytes in place of the previous character and the first byte of the mark
+				uint16_t c3 = (uint16_t)(uint8_t)trtab[1];
+				if (c3 < 0x80)
 				{
-					if ((c & 0xE0) == 0xC0)
-					{
-						charVal = (uint32_t)(c & 0x1F);
-						numContinuationBytesLeft = 1;
-					}
-					else if ((c & 0xF0) == 0xE0)
-					{
-						charVal = (uint32_t)(c & 0x0F);
-						numContinuationBytesLeft = 2;
-					}
-					else if ((c & 0xF8) == 0xF0)
-					{
-						charVal = (uint32_t)(c & 0x07);
-						numContinuationBytesLeft = 3;
-					}
-					else if ((c & 0xFC) == 0xF8)
-					{
-						charVal = (uint32_t)(c & 0x03);
-						numContinuationBytesLeft = 4;
-					}
-					else if ((c & 0xFE) == 0xFC)
-					{
-						charVal = (uint32_t)(c & 0x01);
-						numContinuationBytesLeft = 5;
-					}
+					c3 |= 0x0100;
 				}
+				fieldVal[len - 3] = (c3 >> 6) | 0xC0;
+				fieldVal[len - 2] = (c3 & 0x3F) | 0x80;
+				fieldVal.Truncate(len - 1);
 			}
-			else if ((c & 0xC0) == 0x80)
+		}
+	}
+
+	// Decode the next UTF8 byte of a string value. Return the character if the byte completes a multi-byte character, else 0.
+	static uint32_t DecodeStringByte(char c)
+	{
+		const unsigned char uc = (unsigned char)c;
+		if (utf8BytesLeft == 0)
+		{
+			if (uc >= 0x80)
 			{
-				charVal = (charVal << 6) | (c & 0x3F);
-				--numContinuationBytesLeft;
-				if (numContinuationBytesLeft == 0)
+				if ((uc & 0xE0) == 0xC0)
 				{
-					const char* _ecv_array trtab;
-					switch(charVal)
-					{
-					case 0x0300:	// grave accent
-						trtab = trGrave;
-						break;
-					case 0x0301:	// acute accent
-						trtab = trAcute;
-						break;
-					case 0x0302:	// circumflex
-						trtab = trCircumflex;
-						break;
-					case 0x0303:	// tilde
-						trtab = trTilde;
-						break;
-					case 0x0306:	// breve
-						trtab = trBreve;
-						break;
-					case 0x0308:	// umlaut
-						trtab = trUmlaut;
-						break;
-					case 0x030A:	// small circle
-						trtab = trCircle;
-						break;
-					case 0x030C:	// caron
-						trtab = trCaron;
-						break;
-					case 0x0327:	// cedilla
-						trtab = trCedilla;
-						break;
-					default:
-						trtab = nullptr;
-						break;
-					}
+					utf8CharVal = (uint32_t)(uc & 0x1F);
+					utf8BytesLeft = 1;
+				}
+				else if ((uc & 0xF0) == 0xE0)
+				{
+					utf8CharVal = (uint32_t)(uc & 0x0F);
+					utf8BytesLeft = 2;
+				}
+				else if ((uc & 0xF8) == 0xF0)
+				{
+					utf8CharVal = (uint32_t)(uc & 0x07);
+					utf8BytesLeft = 3;
+				}
+				else if ((uc & 0xFC) == 0xF8)
+				{
+					utf8CharVal = (uint32_t)(uc & 0x03);
+					utf8BytesLeft = 4;
+				}
+				else if ((uc & 0xFE) == 0xFC)
+				{
+					utf8CharVal = (uint32_t)(uc & 0x01);
+					utf8BytesLeft = 5;
+				}
+			}
+		}
+		else if ((uc & 0xC0) == 0x80)
+		{
+			utf8CharVal = (utf8CharVal << 6) | (uc & 0x3F);
+			--utf8BytesLeft;
+			if (utf8BytesLeft == 0)
+			{
+				return utf8CharVal;
+			}
+		}
+		else
+		{
+			// Bad UTF8 state
+			utf8BytesLeft = 0;
+		}
+		return 0;
+	}
+
+	// Return true if the character may be a combining mark that CombineDiacritic handles
+	static bool MayBeDiacritic(uint32_t charVal)
+	{
+		return charVal >= 0x0300 && charVal <= 0x0327;
+	}
+
+	// Add a character to a string value that is being copied into fieldVal, converting combining characters as soon as they arrive.
+	// Converting them here instead of after the closing quote saves a second pass over the string and having to close up the gap each time.
+	// Return true if the string is full.
+	static bool AddStringChar(char c)
+	{
+		if (fieldVal.cat(c))
+		{
+			return true;
+		}
+
+		const uint32_t charVal = DecodeStringByte(c);
+		if (MayBeDiacritic(charVal))
+		{
+			CombineDiacritic(charVal);
+		}
+		return false;
+	}
+
+	// Copy the string value received so far, up to but not including 'end', from the receive buffer into fieldVal so that it can be rewritten.
+	// Return true if it had to be truncated.
+	static bool CopySlice(const volatile char * _ecv_array end)
+	{
+		const bool truncated = fieldVal.copy(const_cast<const char* _ecv_array>(sliceStart), end - sliceStart);
+		ReleaseSlice();
+		return truncated;
+	}
+
+	// Check whether the incoming character signals the end of the value. If it does, process it and return true.
+	static bool CheckValueCompleted(char c, bool doProcess)
+	{
+#if DEBUG
+		MessageLog::AppendMessage("CheckValueCompleted");
+#endif
+		switch(c)
+		{
+		case ',':
+			if (doProcess)
+			{
+				ProcessField();
+			}
+			if (InArray())
+			{
+				++arrayIndices[arrayDepth - 1];
+				fieldVal.Clear();
+				state = jsVal;
+			}
+			else
+			{
+				RemoveLastId();
+				state = jsExpectId;
+			}
+			return true;
+
+		case ']':
+			if (InArray())
+			{
+				if (doProcess)
+				{
+					ProcessField();
+				}
+				++arrayIndices[arrayDepth - 1];
+				EndArray();
+				state = jsEndVal;
+			}
+			else
+			{
+				state = jsError;
+#if DEBUG
+				MessageLog::AppendMessage("jsError: CheckValueCompleted: ]");
+#endif
+			}
+			return true;
+
+		case '}':
+			if (InArray())
+			{
+				state = jsError;
+#if DEBUG
+				MessageLog::AppendMessage("jsError: CheckValueCompleted: }");
+#endif
+			}
+			else
+			{
+				if (doProcess)
+				{
+					ProcessField();
+				}
+				RemoveLastId();
+				if (AtRoot())
+				{
+					EndReceivedMessage();
+					state = jsBegin;
+				}
+				else
+				{
+					RemoveLastIdChar();
+					state = jsEndVal;
+				}
+			}
+			return true;
+
+		default:
+			return false;
+		}
+	}
+
+	// Compact encoding of status responses.
+	// A host that supports it may answer a request that has the 'b' flag with a frame in a subset of CBOR (RFC 8949) instead of a line of JSON.
+	// The frame starts with the CBOR self-describe tag (D9 D9 F7), which can't occur at the start of a JSON line, followed by a single map that holds
+	// the same fields as the JSON would. It is normally followed by a newline, which is ignored. The subset is:
+	// - unsigned and negative integers
+	// - decimal fractions (tag 4) with an integer exponent and mantissa, for numbers with a decimal point
+	// - definite-length text strings
+	// - arrays and maps of definite or indefinite length
+	// - false, true, null, and undefined which is treated as null
+	// Map keys are text strings or key references. The text string keys in a frame are numbered from 0 in the order they arrive, until there have been
+	// MaxCompactKeys of them or there isn't room to store the next one in the key pool. A key that is an unsigned integer n means the same as key number n.
+	// Other tags are ignored. Anything else is an error, and the rest of the line is discarded as it would be after a JSON error.
+	// The values and paths passed to the consumer are exactly the same as for the equivalent JSON, so it doesn't need to know which encoding was used.
+	const size_t MaxCompactNesting = MaxIdNesting + 1;		// the root map doesn't add to the path
+	const size_t MaxCompactKeys = 128;
+	const size_t CompactKeyPoolSize = 1024;
+	const int MaxCompactExponent = 32;					// limits the length of the text we make for a decimal fraction
+
+	enum class CompactDecodeState : uint8_t
+	{
+		header,				// expecting the initial byte of an item
+		argument,			// receiving the bytes of the argument that follows the initial byte
+		text				// receiving the characters of a text string
+	};
+
+	enum class CompactContainer : uint8_t
+	{
+		array,
+		map,
+		decimal				// the exponent and mantissa of a decimal fraction
+	};
+
+	struct CompactLevel
+	{
+		uint32_t itemsLeft;			// for definite length containers, the number of items (or in a map, the number of pairs) still to come
+		CompactContainer type;
+		bool indefinite;
+		bool expectKey;				// in a map, true if the next item is a key
+	};
+
+	CompactDecodeState compactState;
+	uint8_t compactMajorType;
+	uint8_t compactArgBytesLeft;
+	uint64_t compactArg;
+	uint64_t compactTextLeft;
+	bool compactTextIsKey;
+	bool compactDecimalTag;				// true if we had tag 4, so the next item is the array of a decimal fraction
+	int compactExponent;
+	CompactLevel compactLevels[MaxCompactNesting];
+	size_t compactDepth;
+	size_t compactSkipDepth;			// if nonzero, we are skipping an unwanted value in the map at this depth
+	char compactKeyPool[CompactKeyPoolSize];
+	uint16_t compactKeyEnds[MaxCompactKeys];
+	size_t numCompactKeys;
+	size_t compactKeyPoolUsed;
+	size_t compactKeyStart;				// where in the pool the key being received starts
+	bool compactKeyStored;				// true if the key being received is being stored in the pool
+
+	static void CompactError()
+	{
+		state = jsError;
+#if DEBUG
+		MessageLog::AppendMessage("jsError: compact");
+#endif
+	}
+
+	// Start decoding a frame, having received the tag that introduces it
+	static void StartCompactFrame()
+	{
+		compactState = CompactDecodeState::header;
+		compactDecimalTag = false;
+		compactDepth = 0;
+		compactSkipDepth = 0;
+		numCompactKeys = 0;
+		compactKeyPoolUsed = 0;
+		state = jsCompact;
+	}
+
+	// Start a new level of nesting, returning true if there is no room for it
+	static bool PushCompactLevel(CompactContainer type, bool indefinite, uint64_t numItems)
+	{
+		if (compactDepth == MaxCompactNesting || numItems > UINT32_MAX)
+		{
+			return true;
+		}
+		CompactLevel& level = compactLevels[compactDepth++];
+		level.type = type;
+		level.indefinite = indefinite;
+		level.itemsLeft = (uint32_t)numItems;
+		level.expectKey = true;
+		return false;
+	}
+
+	// Finish the innermost container. Return true if it was a value inside another container, so that container now has one more item.
+	static bool CloseCompactContainer()
+	{
+		const CompactContainer type = compactLevels[--compactDepth].type;
+		if (compactSkipDepth == 0)
+		{
+			if (type == CompactContainer::array)
+			{
+				EndArray();
+			}
+			else if (type == CompactContainer::map)
+			{
+				RemoveLastId();
+				if (compactDepth == 0)
+				{
+					EndReceivedMessage();
+					state = jsBegin;
+					return false;
+				}
+				RemoveLastIdChar();
+			}
+		}
+		return true;
+	}
+
+	// Move on after a value has been completed in the innermost container, closing any containers that are now complete
+	static void CompactValueDone()
+	{
+		for (;;)
+		{
+			CompactLevel& level = compactLevels[compactDepth - 1];
+			if (level.type == CompactContainer::map)
+			{
+				if (compactSkipDepth == compactDepth)
+				{
+					compactSkipDepth = 0;			// we have finished skipping the unwanted value
+				}
+				if (compactSkipDepth == 0)
+				{
+					RemoveLastId();
+				}
+				level.expectKey = true;
+			}
+			else if (compactSkipDepth == 0)
+			{
+				++arrayIndices[arrayDepth - 1];
+			}
+
+			if (level.indefinite || --level.itemsLeft != 0 || !CloseCompactContainer())
+			{
+				break;
+			}
+		}
+	}
+
+	// Start a container that is a value
+	static void OpenCompactContainer(CompactContainer type, bool indefinite)
+	{
+		if (PushCompactLevel(type, indefinite, compactArg))
+		{
+			CompactError();
+			return;
+		}
+
+		if (compactSkipDepth == 0)
+		{
+			if (type == CompactContainer::array)
+			{
+				if (arrayDepth == MaxArrayNesting || AddIdSeparator('^'))
+				{
+					CompactError();
+					return;
+				}
+				arrayIndices[arrayDepth] = 0;
+				++arrayDepth;
+			}
+			else if (AddIdSeparator(':'))
+			{
+				CompactError();
+				return;
+			}
+		}
+
+		if (!indefinite && compactArg == 0 && CloseCompactContainer())
+		{
+			CompactValueDone();
+		}
+	}
+
+	// Put a number into fieldVal the way it would have been written in JSON, then pass it on. Decoding it from the text means it is rounded
+	// in the same way as a number received in JSON.
+	static void ProcessCompactNumber(bool negative, uint64_t mantissa, int exponent)
+	{
+		if (compactSkipDepth == 0)
+		{
+			char digits[20];					// enough for any 64-bit number, least significant digit first
+			size_t numDigits = 0;
+			do
+			{
+				digits[numDigits++] = (char)('0' + (mantissa % 10));
+				mantissa /= 10;
+			} while (mantissa != 0);
+
+			fieldVal.Clear();
+			if (negative)
+			{
+				fieldVal.cat('-');
+			}
+			const size_t decimals = (exponent < 0) ? (size_t)-exponent : 0;
+			if (numDigits <= decimals)
+			{
+				fieldVal.cat('0');
+			}
+			for (size_t i = numDigits; i > decimals; )
+			{
+				fieldVal.cat(digits[--i]);
+			}
+			for (int i = 0; i < exponent; ++i)
+			{
+				fieldVal.cat('0');
+			}
+			if (decimals != 0)
+			{
+				fieldVal.cat('.');
+				for (size_t i = decimals; i != 0; )
+				{
+					--i;
+					fieldVal.cat((i < numDigits) ? digits[i] : '0');
+				}
+			}
+
+			StartNumber(negative);
+			bool afterPoint = false;
+			for (const char *p = fieldVal.c_str(); *p != 0; ++p)
+			{
+				if (*p == '.')
+				{
+					afterPoint = true;
+				}
+				else if (*p != '-')
+				{
+					AddDigit(*p, afterPoint);
+				}
+			}
+			ProcessValue((numOverflow) ? ReceivedValue::Kind::floatingPoint
+						: (decimals != 0) ? ReceivedValue::Kind::fixedPoint
+							: ReceivedValue::Kind::integer);
+		}
+		CompactValueDone();
+	}
+
+	// Handle an integer, which may be a value or part of a decimal fraction
+	static void CompactInteger(bool negative, uint64_t magnitude)
+	{
+		CompactLevel& level = compactLevels[compactDepth - 1];
+		if (level.type != CompactContainer::decimal)
+		{
+			ProcessCompactNumber(negative, magnitude, 0);
+		}
+		else if (level.itemsLeft == 2)
+		{
+			if (magnitude > MaxCompactExponent)
+			{
+				CompactError();
+				return;
+			}
+			compactExponent = (negative) ? -(int)magnitude : (int)magnitude;
+			--level.itemsLeft;
+		}
+		else
+		{
+			--compactDepth;
+			ProcessCompactNumber(negative, magnitude, compactExponent);
+		}
+	}
+
+	// Pass on a value that is held as text in fieldVal
+	static void CompactTextValue()
+	{
+		if (compactSkipDepth == 0)
+		{
+			ProcessValue(ReceivedValue::Kind::text);
+		}
+		fieldVal.Clear();
+		CompactValueDone();
+	}
+
+	// Add a character to the path for the key being received
+	static void AddCompactKeyChar(char c)
+	{
+		if (compactSkipDepth == 0 && c != ':' && c != '^')
+		{
+			fieldIdHash = StringHashAdd(fieldIdHash, c);
+		}
+	}
+
+	static void StartCompactKey()
+	{
+		compactKeyStart = compactKeyPoolUsed;
+		compactKeyStored = (numCompactKeys < MaxCompactKeys);
+	}
+
+	// Add a character of a text string key to the path and to the key pool
+	static void CompactKeyChar(char c)
+	{
+		AddCompactKeyChar(c);
+		if (compactKeyStored)
+		{
+			if (compactKeyPoolUsed < CompactKeyPoolSize)
+			{
+				compactKeyPool[compactKeyPoolUsed++] = c;
+			}
+			else
+			{
+				compactKeyStored = false;			// it doesn't fit, so it doesn't get a number
+				compactKeyPoolUsed = compactKeyStart;
+			}
+		}
+	}
+
+	// Finish a key. If it was a text string that we stored, number it. Then decide whether we want the value.
+	static void EndCompactKey(bool wasText)
+	{
+		if (wasText && compactKeyStored)
+		{
+			compactKeyEnds[numCompactKeys++] = (uint16_t)compactKeyPoolUsed;
+		}
+		if (compactSkipDepth == 0)
+		{
+			if (AtRoot())
+			{
+				fieldIdHash = TranslateRootFieldId(fieldIdHash);
+			}
+			if (!IsFieldIdWanted(fieldIdHash))
+			{
+				compactSkipDepth = compactDepth;
+			}
+		}
+		compactLevels[compactDepth - 1].expectKey = false;
+	}
+
+	// Handle an item that is a map key
+	static void CompactKey(bool indefinite)
+	{
+		if (compactMajorType == 3 && !indefinite)
+		{
+			StartCompactKey();
+			if (compactArg == 0)
+			{
+				EndCompactKey(true);
+			}
+			else
+			{
+				compactTextLeft = compactArg;
+				compactTextIsKey = true;
+				compactState = CompactDecodeState::text;
+			}
+		}
+		else if (compactMajorType == 0 && !indefinite && compactArg < numCompactKeys)
+		{
+			const size_t start = (compactArg == 0) ? 0 : compactKeyEnds[compactArg - 1];
+			for (size_t i = start; i < compactKeyEnds[compactArg]; ++i)
+			{
+				AddCompactKeyChar(compactKeyPool[i]);
+			}
+			EndCompactKey(false);
+		}
+		else
+		{
+			CompactError();
+		}
+	}
+
+	// Handle an item now that we have its initial byte and argument
+	static void CompactItem(bool indefinite)
+	{
+		if (compactDepth == 0)
+		{
+			// The frame must hold a single map
+			if (compactMajorType == 5 && !compactDecimalTag && !PushCompactLevel(CompactContainer::map, indefinite, compactArg))
+			{
+				StartReceivedMessage();
+				fieldVal.Clear();
+				fieldIdHash = StringHashInit;
+				idDepth = 0;
+				arrayDepth = 0;
+				if (!indefinite && compactArg == 0)
+				{
+					(void)CloseCompactContainer();
+				}
+			}
+			else
+			{
+				CompactError();
+			}
+			return;
+		}
+
+		CompactLevel& level = compactLevels[compactDepth - 1];
+		if (compactMajorType == 7 && indefinite)
+		{
+			// A break, which ends an indefinite length container
+			if (level.indefinite && level.expectKey && !compactDecimalTag && CloseCompactContainer())
+			{
+				CompactValueDone();
+			}
+			else if (state == jsCompact)
+			{
+				CompactError();
+			}
+			return;
+		}
 
-					// If it is a diacritical mark that we handle, try to combine it with the previous character.
-					// The diacritical marks are in the range 03xx so they are encoded as 2 UTF8 bytes.
-					if (trtab != nullptr && i > 2)
-					{
-						const char c2 = fieldVal[i - 3];
-						while (*trtab != 0 && *trtab != c2)
-						{
-							trtab += 2;
-						}
-						if (*trtab != 0)
-						{
-							// Get the translated character and encode it as 2 UTF8 bytes
-							uint16_t c3 = (uint16_t)(uint8_t)trtab[1];
-							if (c3 < 0x80)
-							{
-								c3 |= 0x0100;
-							}
-							fieldVal[i - 3] = (c3 >> 6) | 0xC0;
-							fieldVal[i - 2] = (c3 & 0x3F) | 0x80;
-							fieldVal.Erase(i - 1);
-							--i;
-						}
-					}
-				}
+		if (level.type == CompactContainer::map && level.expectKey)
+		{
+			if (compactDecimalTag)
+			{
+				CompactError();
 			}
 			else
 			{
-				// Bad UTF8 state
-				numContinuationBytesLeft = 0;
+				CompactKey(indefinite);
 			}
+			return;
 		}
-	}
 
-	// Check whether the incoming character signals the end of the value. If it does, process it and return true.
-	static bool CheckValueCompleted(char c, bool doProcess)
-	{
-#if DEBUG
-		MessageLog::AppendMessage("CheckValueCompleted");
-#endif
-		switch(c)
+		if (compactDecimalTag)
 		{
-		case ',':
-			if (doProcess)
+			// The item after tag 4 must be an array of the exponent and the mantissa
+			compactDecimalTag = false;
+			if (compactMajorType != 4 || indefinite || compactArg != 2 || PushCompactLevel(CompactContainer::decimal, false, 2))
 			{
-				ProcessField();
+				CompactError();
 			}
-			if (InArray())
+			return;
+		}
+
+		if (level.type == CompactContainer::decimal && compactMajorType > 1)
+		{
+			CompactError();
+			return;
+		}
+
+		switch (compactMajorType)
+		{
+		case 0:			// unsigned integer
+			CompactInteger(false, compactArg);
+			break;
+
+		case 1:			// negative integer, -1 - argument
+			if (compactArg == UINT64_MAX)
 			{
-				++arrayIndices[arrayDepth - 1];
-				fieldVal.Clear();
-				state = jsVal;
+				CompactError();
 			}
 			else
 			{
-				RemoveLastId();
-				state = jsExpectId;
+				CompactInteger(true, compactArg + 1);
 			}
-			return true;
+			break;
 
-		case ']':
-			if (InArray())
+		case 3:			// text string
+			if (indefinite)
 			{
-				if (doProcess)
+				CompactError();
+			}
+			else
+			{
+				fieldVal.Clear();
+				utf8BytesLeft = 0;
+				if (compactArg == 0)
 				{
-					ProcessField();
+					CompactTextValue();
+				}
+				else
+				{
+					compactTextLeft = compactArg;
+					compactTextIsKey = false;
+					compactState = CompactDecodeState::text;
 				}
-				++arrayIndices[arrayDepth - 1];
-				EndArray();
-				state = jsEndVal;
 			}
-			else
+			break;
+
+		case 4:			// array
+			OpenCompactContainer(CompactContainer::array, indefinite);
+			break;
+
+		case 5:			// map
+			OpenCompactContainer(CompactContainer::map, indefinite);
+			break;
+
+		case 6:			// tag, which applies to the next item
+			if (indefinite)
 			{
-				state = jsError;
-#if DEBUG
-				MessageLog::AppendMessage("jsError: CheckValueCompleted: ]");
-#endif
+				CompactError();
 			}
-			return true;
+			else if (compactArg == 4)
+			{
+				compactDecimalTag = true;
+			}
+			break;
 
-		case '}':
-			if (InArray())
+		case 7:			// simple values
+			switch (compactArg)
 			{
-				state = jsError;
-#if DEBUG
-				MessageLog::AppendMessage("jsError: CheckValueCompleted: }");
-#endif
+			case 20:
+				fieldVal.copy("false");
+				CompactTextValue();
+				break;
+			case 21:
+				fieldVal.copy("true");
+				CompactTextValue();
+				break;
+			case 22:	// null
+			case 23:	// undefined
+				fieldVal.Clear();
+				CompactTextValue();
+				break;
+			default:
+				CompactError();
+				break;
 			}
-			else
+			break;
+
+		default:		// byte strings aren't part of the subset
+			CompactError();
+			break;
+		}
+	}
+
+	// Decode a span of received bytes that belong to a frame in the compact encoding. Return the number of bytes used, which is fewer than
+	// we were given if the frame ended or we found an error.
+	static size_t ParseCompactSpan(const volatile char * _ecv_array p, size_t len)
+	{
+		size_t used = 0;
+		while (used < len && state == jsCompact)
+		{
+			const uint8_t b = (uint8_t)p[used++];
+			switch (compactState)
 			{
-				if (doProcess)
+			case CompactDecodeState::header:
 				{
-					ProcessField();
+					compactMajorType = b >> 5;
+					const uint8_t info = b & 0x1F;
+					if (info < 24)
+					{
+						compactArg = info;
+						CompactItem(false);
+					}
+					else if (info < 28 && (compactMajorType != 7 || info == 24))		// floating point numbers aren't part of the subset
+					{
+						compactArg = 0;
+						compactArgBytesLeft = 1u << (info - 24);
+						compactState = CompactDecodeState::argument;
+					}
+					else if (info == 31 && compactMajorType >= 2 && compactMajorType != 6)
+					{
+						compactArg = 0;
+						CompactItem(true);
+					}
+					else
+					{
+						CompactError();
+					}
 				}
-				RemoveLastId();
-				if (fieldId.strlen() == 0)
+				break;
+
+			case CompactDecodeState::argument:
+				compactArg = (compactArg << 8) | b;
+				if (--compactArgBytesLeft == 0)
 				{
-					EndReceivedMessage();
-					state = jsBegin;
+					compactState = CompactDecodeState::header;
+					CompactItem(false);
 				}
-				else
+				break;
+
+			case CompactDecodeState::text:
+				if (compactTextIsKey)
 				{
-					RemoveLastIdChar();
-					state = jsEndVal;
+					CompactKeyChar((char)b);
+				}
+				else if (compactSkipDepth == 0)
+				{
+					// Treat control characters the same as the JSON parser treats escaped ones
+					if (b >= ' ')
+					{
+						(void)AddStringChar((char)b);
+					}
+					else if (b == '\n' || b == '\t')
+					{
+						(void)AddStringChar(' ');
+					}
+				}
+				if (--compactTextLeft == 0)
+				{
+					compactState = CompactDecodeState::header;
+					if (compactTextIsKey)
+					{
+						EndCompactKey(true);
+					}
+					else
+					{
+						CompactTextValue();
+					}
 				}
+				break;
 			}
-			return true;
-
-		default:
-			return false;
 		}
+		return used;
 	}
 
-	// This is the JSON parser state machine
-	void CheckInput()
+	// This is the JSON parser state machine. It is run over a contiguous span of received characters.
+	static void ParseSpan(volatile char * _ecv_array p, size_t len)
 	{
-		while (nextIn != nextOut)
+		if (state == jsCompact)
+		{
+			// Carry on decoding a frame in the compact encoding that started in an earlier span
+			const size_t used = ParseCompactSpan(p, len);
+			p += used;
+			len -= used;
+			if (state == jsError)
+			{
+				++parseErrorsByState[jsCompact];
+				++linkCounters.parseErrors;
+			}
+		}
+
+		while (len != 0)
 		{
-			char c = rxBuffer[nextOut];
-			nextOut = (nextOut + 1) % rxBufsize;
+			const char c = *p++;
+			--len;
 			if (c == '\n')
 			{
+				++linkCounters.rxLines;
 				if (state == jsError)
 				{
 #if DEBUG
@@ -464,10 +1613,12 @@ namespace SerialIo
 #endif
 					ParserErrorEncountered(); // Notify the consumer that we ran into an error
 				}
+				ReleaseSlice();
 				state = jsBegin;		// abandon current parse (if any) and start again
 			}
 			else
 			{
+				const JsonState previousState = state;
 				switch(state)
 				{
 				case jsBegin:			// initial state, expecting '{'
@@ -476,9 +1627,35 @@ namespace SerialIo
 						StartReceivedMessage();
 						state = jsExpectId;
 						fieldVal.Clear();
-						fieldId.Clear();
+						fieldIdHash = StringHashInit;
+						idDepth = 0;
 						arrayDepth = 0;
 					}
+					else if (c == '\xD9')
+					{
+						state = jsCompactTag1;
+					}
+					break;
+
+				case jsCompactTag1:
+					state = (c == '\xD9') ? jsCompactTag2 : jsBegin;
+					break;
+
+				case jsCompactTag2:
+					if (c == '\xF7')
+					{
+						StartCompactFrame();
+						const size_t used = ParseCompactSpan(p, len);
+						p += used;
+						len -= used;
+					}
+					else
+					{
+						state = jsBegin;
+					}
+					break;
+
+				case jsCompact:			// ParseCompactSpan handles this state
 					break;
 
 				case jsExpectId:		// expecting a quoted ID
@@ -491,7 +1668,7 @@ namespace SerialIo
 						break;
 					case '}':			// empty object, or extra comma at end of field list
 						RemoveLastId();
-						if (fieldId.strlen() == 0)
+						if (AtRoot())
 						{
 							EndReceivedMessage();
 							state = jsBegin;
@@ -515,6 +1692,10 @@ namespace SerialIo
 					switch (c)
 					{
 					case '"':
+						if (AtRoot())
+						{
+							fieldIdHash = TranslateRootFieldId(fieldIdHash);
+						}
 						state = jsHadId;
 						break;
 					default:
@@ -527,13 +1708,7 @@ namespace SerialIo
 						}
 						else if (c != ':' && c != '^')
 						{
-							if (fieldId.cat(c))
-							{
-								state = jsError;
-#if DEBUG
-								MessageLog::AppendMessage("jsError: jsId 2");
-#endif
-							}
+							fieldIdHash = StringHashAdd(fieldIdHash, c);
 						}
 						break;
 					}
@@ -543,7 +1718,16 @@ namespace SerialIo
 					switch(c)
 					{
 					case ':':
-						state = jsVal;
+						if (IsFieldIdWanted(fieldIdHash))
+						{
+							state = jsVal;
+						}
+						else
+						{
+							skipDepth = 0;
+							skipInString = skipEscape = false;
+							state = jsSkipVal;
+						}
 						break;
 					case ' ':
 						break;
@@ -563,10 +1747,12 @@ namespace SerialIo
 						break;
 					case '"':
 						fieldVal.Clear();
+						utf8BytesLeft = 0;
+						PinSlice(p);
 						state = jsStringVal;
 						break;
 					case '[':
-						if (arrayDepth < MaxArrayNesting && !fieldId.cat('^'))
+						if (arrayDepth < MaxArrayNesting && !AddIdSeparator('^'))
 						{
 							arrayIndices[arrayDepth] = 0;		// start an array
 							++arrayDepth;
@@ -596,10 +1782,11 @@ namespace SerialIo
 					case '-':
 						fieldVal.Clear();
 						fieldVal.cat(c);
+						StartNumber(true);
 						state = jsNegIntVal;
 						break;
 					case '{':					// start of a nested object
-						state = (!fieldId.cat(':')) ? jsExpectId : jsError;
+						state = (!AddIdSeparator(':')) ? jsExpectId : jsError;
 #if DEBUG
 						if (state == jsError)
 						{
@@ -612,6 +1799,8 @@ namespace SerialIo
 						{
 							fieldVal.Clear();
 							fieldVal.cat(c);	// must succeed because we just cleared fieldVal
+							StartNumber(false);
+							AddDigit(c, false);
 							state = jsIntVal;
 						}
 						else if (c >= 'a' && c <= 'z')
@@ -634,24 +1823,42 @@ namespace SerialIo
 					switch (c)
 					{
 					case '"':
-						ConvertUnicode();
+						if (sliceStart != nullptr)
+						{
+							p[-1] = 0;			// terminate the value in the receive buffer in place of the closing quote
+						}
 						ProcessField();
+						ReleaseSlice();
 						state = jsEndVal;
 						break;
 					case '\\':
+						if (sliceStart != nullptr)
+						{
+							(void)CopySlice(p - 1);
+						}
 						state = jsStringEscape;
 						break;
 					default:
 						if (c < ' ')
 						{
+							ReleaseSlice();
 							state = jsError;
 #if DEBUG
 							MessageLog::AppendMessage("jsError: jsStringVal");
 #endif
 						}
+						else if (sliceStart == nullptr)
+						{
+							(void)AddStringChar(c);	// ignore any error so that long string parameters just get truncated
+						}
 						else
 						{
-							fieldVal.cat(c);	// ignore any error so that long string parameters just get truncated
+							// The value can stay where it is unless it has a combining mark that we need to merge into the previous character
+							const uint32_t charVal = DecodeStringByte(c);
+							if (MayBeDiacritic(charVal) && !CopySlice(p))
+							{
+								CombineDiacritic(charVal);
+							}
 						}
 						break;
 					}
@@ -665,7 +1872,7 @@ namespace SerialIo
 						case '"':
 						case '\\':
 						case '/':
-							if (fieldVal.cat(c))
+							if (AddStringChar(c))
 							{
 								state = jsError;
 #if DEBUG
@@ -675,7 +1882,7 @@ namespace SerialIo
 							break;
 						case 'n':
 						case 't':
-							if (fieldVal.cat(' '))		// replace newline and tab by space
+							if (AddStringChar(' '))		// replace newline and tab by space
 							{
 								state = jsError;
 #if DEBUG
@@ -694,13 +1901,18 @@ namespace SerialIo
 					break;
 
 				case jsNegIntVal:		// had '-' so expecting a integer value
-					state = (c >= '0' && c <= '9' && !fieldVal.cat(c)) ? jsIntVal : jsError;
+					if (c >= '0' && c <= '9' && !fieldVal.cat(c))
+					{
+						AddDigit(c, false);
+						state = jsIntVal;
+					}
+					else
+					{
+						state = jsError;
 #if DEBUG
-						if (state == jsError)
-						{
-							MessageLog::AppendMessage("jsError: jsNegIntVal");
-						}
+						MessageLog::AppendMessage("jsError: jsNegIntVal");
 #endif
+					}
 					break;
 
 				case jsIntVal:			// receiving an integer value
@@ -719,7 +1931,11 @@ namespace SerialIo
 						}
 #endif
 					}
-					else if (!(c >= '0' && c <= '9' && !fieldVal.cat(c)))
+					else if (c >= '0' && c <= '9' && !fieldVal.cat(c))
+					{
+						AddDigit(c, false);
+					}
+					else
 					{
 						state = jsError;
 #if DEBUG
@@ -734,7 +1950,11 @@ namespace SerialIo
 						break;
 					}
 
-					if (!(c >= '0' && c <= '9' && !fieldVal.cat(c)))
+					if (c >= '0' && c <= '9' && !fieldVal.cat(c))
+					{
+						AddDigit(c, true);
+					}
+					else
 					{
 						state = jsError;
 #if DEBUG
@@ -758,6 +1978,56 @@ namespace SerialIo
 					}
 					break;
 
+				case jsSkipVal:			// skipping an unwanted value, so we need only track strings and nesting to find where it ends
+					if (skipInString)
+					{
+						if (skipEscape)
+						{
+							skipEscape = false;
+						}
+						else if (c == '\\')
+						{
+							skipEscape = true;
+						}
+						else if (c == '"')
+						{
+							skipInString = false;
+						}
+					}
+					else
+					{
+						switch (c)
+						{
+						case '"':
+							skipInString = true;
+							break;
+						case '{':
+						case '[':
+							++skipDepth;
+							break;
+						case '}':
+						case ']':
+							if (skipDepth == 0)
+							{
+								(void)CheckValueCompleted(c, false);
+							}
+							else
+							{
+								--skipDepth;
+							}
+							break;
+						case ',':
+							if (skipDepth == 0)
+							{
+								(void)CheckValueCompleted(c, false);
+							}
+							break;
+						default:
+							break;
+						}
+					}
+					break;
+
 				case jsEndVal:			// had the end of a string or array value, expecting comma or ] or }
 					if (CheckValueCompleted(c, false))
 					{
@@ -774,37 +2044,176 @@ namespace SerialIo
 					// Ignore all characters. State will be reset to jsBegin at the start of this function when we receive a newline.
 					break;
 				}
+				if (state == jsError && previousState != jsError)
+				{
+					++parseErrorsByState[previousState];
+					++linkCounters.parseErrors;
+				}
 			}
 		}
+
+		// A string value can only be left in the receive buffer if it is contiguous, and if holding it won't stop the PDC receiving
+		if (sliceStart != nullptr && (p == rxBuffer + rxBufsize || (size_t)(p - sliceStart) > MaxSliceLength))
+		{
+			(void)CopySlice(p);
+		}
 	}
 
-	// Called by the ISR to store a received character.
-	// If the buffer is full, we wait for the next end-of-line.
-	void receiveChar(char c)
+	// Parse everything the PDC has received since the last call
+	void CheckInput()
 	{
-		if (c == '\n')
+		for (;;)
 		{
-			inError = false;
+			size_t localNextIn = GetReceivePosition();
+			const bool hadError = rxErrorPending;
+			if (hadError)
+			{
+				localNextIn = rxErrorPos;			// only parse up to the point where characters were lost
+			}
+
+			if (localNextIn != nextOut)
+			{
+				const size_t spanEnd = (localNextIn > nextOut) ? localNextIn : rxBufsize;
+				linkCounters.rxBytes += spanEnd - nextOut;
+				ParseSpan(rxBuffer + nextOut, spanEnd - nextOut);
+				nextOut = spanEnd % rxBufsize;
+			}
+			else if (hadError)
+			{
+				if (state != jsError)
+				{
+					++linkCounters.linesLost;
+				}
+				state = jsError;					// the line we are receiving is incomplete, so abandon it
+				ReleaseSlice();
+
+				// If there have been more errors since this one, we don't know where those in between were, so everything up to the last one is suspect.
+				// We skip it and abandon the line that the last one was in too. The ISR mustn't record another error while we do this.
+				const irqflags_t flags = cpu_irq_save();
+				const size_t lastErrorPos = rxLastErrorPos;
+				if (lastErrorPos != nextOut)
+				{
+					linkCounters.rxBytes += (lastErrorPos + rxBufsize - nextOut) % rxBufsize;
+					nextOut = lastErrorPos;
+				}
+				rxErrorPending = false;
+				cpu_irq_restore(flags);
+			}
+			else
+			{
+				break;
+			}
+
+			// If the ISR ran out of free blocks to give the PDC, we may have made room for another one now.
+			// The ENDRX interrupt is disabled while the receiver is stalled, so we can't race with the ISR here.
+			if (rxStalled && CanQueueReceiveBlock())
+			{
+				QueueReceiveBlock();
+				rxStalled = false;
+				uart_enable_interrupt(UARTn, UART_IER_ENDRX);
+			}
 		}
-		if (!inError)
+	}
+
+	uint32_t GetReceivedCount()
+	{
+		return linkCounters.rxBytes;
+	}
+
+	uint32_t GetReceiveErrorCount()
+	{
+		return overrunErrors + framingErrors;
+	}
+
+	const LinkCounters& GetLinkCounters()
+	{
+		linkCounters.txBytes = txBytes;
+		linkCounters.txLines = txLines;
+		linkCounters.overrunErrors = overrunErrors;
+		linkCounters.framingErrors = framingErrors;
+		return linkCounters;
+	}
+
+	void ListParseErrors(const StringRef& s)
+	{
+		for (size_t i = 0; i < ARRAY_SIZE(parseErrorsByState); ++i)
 		{
-			size_t temp = (nextIn + 1) % rxBufsize;
-			if (temp == nextOut)
+			if (parseErrorsByState[i] != 0)
 			{
-				inError = true;
+				s.catf(" %s %u", jsonStateNames[i], (unsigned int)parseErrorsByState[i]);
 			}
-			else
+		}
+	}
+
+	// Return true if every line that has been queued has been handed to the UART. The UART may still be shifting out the last character.
+	bool IsTransmitIdle()
+	{
+		if (txBusy)
+		{
+			return false;
+		}
+		for (const LineSlot& slot : lineSlots)
+		{
+			if (slot.state == SlotState::queued && !IsHeld(slot))
 			{
-				rxBuffer[nextIn] = c;
-				nextIn = temp;
+				return false;
 			}
 		}
+		return true;
+	}
+
+	// Called by the ISR when the PDC has filled a block and moved on to the next one
+	void receiveBlockDone()
+	{
+		if (CanQueueReceiveBlock())
+		{
+			QueueReceiveBlock();
+		}
+		else
+		{
+			// Leave ENDRX set and stop interrupting on it until CheckInput has made room.
+			// If the PDC fills the current block before then, the UART will report an overrun.
+			rxStalled = true;
+			uart_disable_interrupt(UARTn, UART_IDR_ENDRX);
+		}
 	}
 
-	// Called by the ISR to signify an error. We wait for the next end of line.
-	void receiveError()
+	// Called by the ISR to signify an error. We abandon the line that was being received when it happened.
+	// If CheckInput hasn't dealt with an earlier error yet, we keep the position of that one, because the data is only good up to there.
+	void receiveError(uint32_t status)
 	{
-		inError = true;
+		const size_t pos = GetReceivePosition();
+		if (!rxErrorPending)
+		{
+			rxErrorPos = pos;
+			rxErrorPending = true;
+		}
+		rxLastErrorPos = pos;
+		if (status & UART_SR_OVRE)
+		{
+			++overrunErrors;
+		}
+		if (status & UART_SR_FRAME)
+		{
+			++framingErrors;
+		}
+	}
+
+	// Called by the ISR when the PDC has finished sending a line
+	void transmitDone()
+	{
+		if (txBusy)
+		{
+			++commandsSent[(size_t)sending->cls];
+			sending->state = SlotState::free;
+			sending = nullptr;
+			txBusy = false;
+			StartTransmit();
+		}
+		if (!txBusy)
+		{
+			uart_disable_interrupt(UARTn, UART_IDR_ENDTX);		// nothing more to send, and ENDTX stays set while the PDC is idle
+		}
 	}
 }
 
@@ -818,17 +2227,23 @@ extern "C" {
 	{
 		uint32_t status = UARTn->UART_SR;
 
-		// Did we receive data ?
-		if ((status & UART_SR_RXRDY) == UART_SR_RXRDY)
+		// Has the PDC filled a receive block?
+		if ((status & UART_SR_ENDRX) == UART_SR_ENDRX && (UARTn->UART_IMR & UART_IMR_ENDRX) != 0)
+		{
+			SerialIo::receiveBlockDone();
+		}
+
+		// Has the PDC finished sending a block?
+		if ((status & UART_SR_ENDTX) == UART_SR_ENDTX)
 		{
-			SerialIo::receiveChar(UARTn->UART_RHR);
+			SerialIo::transmitDone();
 		}
 
 		// Acknowledge errors
 		if (status & (UART_SR_OVRE | UART_SR_FRAME))
 		{
 			UARTn->UART_CR |= UART_CR_RSTSTA;
-			SerialIo::receiveError();
+			SerialIo::receiveError(status);
 		}
 	}
 
@@ -16,14 +16,59 @@
 #undef result
 #undef value
 
+class StringRef;
+
 namespace SerialIo
 {
-	void Init(uint32_t baudRate);
+	// Outgoing commands are queued a line at a time and sent most urgent class first. Lines of the same class are sent in the order they were queued.
+	enum class CommandClass : uint8_t
+	{
+		emergency = 0,		// emergency stop, which also discards any less urgent lines that have not been started
+		userAction,			// anything the user asked for that isn't one of the other classes
+		jog,				// movement commands from the jog buttons and the encoder
+		fileRequest,		// file lists, file information and mounting cards
+		statusPoll			// status requests, which are dropped rather than waited for if the queue is full
+	};
+	const size_t NumCommandClasses = 5;
+
+	struct CommandCounters
+	{
+		uint32_t queued;	// lines queued for sending
+		uint32_t sent;		// lines that the UART has finished sending
+		uint32_t dropped;	// lines discarded without being sent
+		uint32_t merged;	// status polls not queued because an identical one was still waiting
+	};
+
+	// Counts of what has happened on the link since we started, for diagnostics
+	struct LinkCounters
+	{
+		uint32_t rxBytes;				// characters received
+		uint32_t rxLines;				// lines received, including those that were abandoned
+		uint32_t txBytes;				// characters sent, including line numbers and checksums
+		uint32_t txLines;				// lines sent
+		uint32_t overrunErrors;			// characters lost because the PDC couldn't keep up
+		uint32_t framingErrors;			// characters received without a valid stop bit
+		uint32_t linesLost;				// lines abandoned because of overrun or framing errors
+		uint32_t parseErrors;			// lines abandoned because the parser couldn't make sense of them
+	};
+
+	void Init(uint32_t baudRate);					// lines held back by HoldTransmit are kept, to be sent at the new baud rate
+	bool IsBaudRateAccurate(uint32_t baudRate);		// true if the UART can generate this baud rate closely enough
+	bool IsTransmitIdle();							// true if everything we have queued, apart from lines held back, has gone to the UART
+	void HoldTransmit();							// don't send lines queued from now on until ReleaseTransmit is called
+	void ReleaseTransmit();
+	void SetCommandClass(CommandClass cls);		// set the class of the line being sent, which reverts to userAction at the end of the line
+	const CommandCounters& GetCommandCounters(CommandClass cls);
 	void SendChar(char c);
 	size_t Sendf(const char *fmt, ...) noexcept;
 	void SendFilename(const char * _ecv_array dir, const char * _ecv_array name);
 	void SendFloat(float f);
+	bool WasLineQueued();							// true if the last line we sent was queued, false if it was dropped or merged with an identical status poll
 	void CheckInput();
+	uint32_t GetReceivedCount();					// total number of characters received, for measuring the size of responses
+	uint32_t GetReceiveErrorCount();				// total number of framing and overrun errors
+	const LinkCounters& GetLinkCounters();
+	void ListParseErrors(const StringRef& s);		// append the number of parse errors in each parser state that has had any
 }
 
 #endif /* SERIALIO_H_ */
@@ -52,6 +52,7 @@
 #include "UTFT.hpp"
 #include "memorysaver.h"
 #include <cstring>			// for strchr
+#include <algorithm>			// for std::min
 
 // Write the previous 16-bit data again the specified number of times.
 // Only supported in 9 and 16 bit modes. Used to speed up setting large blocks of pixels to the same colour.
@@ -74,8 +75,7 @@ template <class T> inline void swap(T& a, T& b)
 UTFT::UTFT(DisplayType model, unsigned int RS, unsigned int WR, unsigned int CS, unsigned int RST, unsigned int SER_LATCH)
 	: fcolour(0xFFFF), bcolour(0), transparentBackground(false),
 	  displayModel(model),
-	  portRS(RS), portWR(WR), portCS(CS), portRST(RST), portSDA(RS), portSCL(SER_LATCH),
-	  numContinuationBytesLeft(0)
+	  portRS(RS), portWR(WR), portCS(CS), portRST(RST), portSDA(RS), portSCL(SER_LATCH)
 {
 	switch (model)
 	{
@@ -246,7 +246,7 @@ void UTFT::InitLCD(DisplayOrientation po, bool is24bit, bool isER)
 	textXpos = 0;
 	textYpos = 0;
 	lastCharColData = 0UL;
-	numContinuationBytesLeft = 0;
+	decoder = Utf8Decoder();
 
 	removeReset();
 	delay_ms(5);
@@ -1926,72 +1926,82 @@ void UTFT::clearToMargin()
 	}
 }
 
-// Write a UTF8 byte.
-// If textYpos is off the end of the display, then don't write anything, just update textXpos and lastCharColData
-size_t UTFT::write(uint8_t c)
+bool Utf8Decoder::Decode(uint8_t b, uint16_t& c)
 {
 	if (numContinuationBytesLeft == 0)
 	{
-		if (c < 0x80)
+		if (b < 0x80)
 		{
-			return writeNative(c);
+			c = b;
+			return true;
 		}
-		else if ((c & 0xE0) == 0xC0)
+		else if ((b & 0xE0) == 0xC0)
 		{
-			charVal = (uint32_t)(c & 0x1F);
+			charVal = (uint32_t)(b & 0x1F);
 			numContinuationBytesLeft = 1;
-			return 1;
+			return false;
 		}
-		else if ((c & 0xF0) == 0xE0)
+		else if ((b & 0xF0) == 0xE0)
 		{
-			charVal = (uint32_t)(c & 0x0F);
+			charVal = (uint32_t)(b & 0x0F);
 			numContinuationBytesLeft = 2;
-			return 1;
+			return false;
 		}
-		else if ((c & 0xF8) == 0xF0)
+		else if ((b & 0xF8) == 0xF0)
 		{
-			charVal = (uint32_t)(c & 0x07);
+			charVal = (uint32_t)(b & 0x07);
 			numContinuationBytesLeft = 3;
-			return 1;
+			return false;
 		}
-		else if ((c & 0xFC) == 0xF8)
+		else if ((b & 0xFC) == 0xF8)
 		{
-			charVal = (uint32_t)(c & 0x03);
+			charVal = (uint32_t)(b & 0x03);
 			numContinuationBytesLeft = 4;
-			return 1;
+			return false;
 		}
-		else if ((c & 0xFE) == 0xFC)
+		else if ((b & 0xFE) == 0xFC)
 		{
-			charVal = (uint32_t)(c & 0x01);
+			charVal = (uint32_t)(b & 0x01);
 			numContinuationBytesLeft = 5;
-			return 1;
+			return false;
 		}
 		else
 		{
-			return writeNative(0x7F);
+			c = 0x7F;
+			return true;
 		}
 	}
-	else if ((c & 0xC0) == 0x80)
+	else if ((b & 0xC0) == 0x80)
 	{
-		charVal = (charVal << 6) | (c & 0x3F);
+		charVal = (charVal << 6) | (b & 0x3F);
 		--numContinuationBytesLeft;
 		if (numContinuationBytesLeft == 0)
 		{
-			return writeNative((charVal < 0x10000) ? (uint16_t)charVal : 0x007F);
+			c = (charVal < 0x10000) ? (uint16_t)charVal : 0x007F;
+			return true;
 		}
 		else
 		{
-			return 1;
+			return false;
 		}
 	}
 	else
 	{
 		// Bad UTF8 state
 		numContinuationBytesLeft = 0;
-		return writeNative(0x7F);
+		c = 0x7F;
+		return true;
 	}
 }
 
+// Write a UTF8 byte.
+// If textYpos is off the end of the display, then don't write anything, just update textXpos and lastCharColData
+size_t UTFT::write(uint8_t c)
+{
+	uint16_t ch;
+	return (decoder.Decode(c, ch)) ? writeNative(ch) : 1;
+}
+
 // Write a character. Always returns the number of bytes consumed i.e. 1.
 // If textYpos is off the end of the display, then don't write anything, just update textXpos and lastCharColData
 size_t UTFT::writeNative(uint16_t c)
@@ -2019,9 +2029,10 @@ size_t UTFT::writeNative(uint16_t c)
     uint8_t nCols = *(uint8_t*)(fontPtr++);
 	assertCS();
 
+	uint8_t numSpaces = 0;
 	if (lastCharColData != 0)	// if we have written anything other than spaces
 	{
-		uint8_t numSpaces = cfont.spaces;
+		numSpaces = cfont.spaces;
 
 		// Decide whether to add the full number of space columns first (auto-kerning)
 		// We don't add a space column before a space character.
@@ -2039,97 +2050,144 @@ size_t UTFT::writeNative(uint16_t c)
 		{
 			--numSpaces;	// kern the character pair
 		}
-		while (numSpaces != 0 && textXpos < textRightMargin)
+	}
+
+	if (!transparentBackground && ySize != 0)
+	{
+		// Opaque text. Draw the space columns and the character in a single window, as much of them as fits before the margin.
+		const uint16_t numCellCols = (textXpos < textRightMargin) ? std::min<uint16_t>(numSpaces + nCols, textRightMargin - textXpos) : 0;
+		if (numCellCols != 0)
+		{
+			writeOpaqueCell(fontPtr, numSpaces, numCellCols, bytesPerColumn, ySize);
+		}
+		for (uint16_t i = numSpaces; i < numCellCols; ++i)
 		{
-			// Add a single space column after the character
-			if (ySize != 0 && !transparentBackground)
+			const uint32_t colData = *(uint32_t*)(fontPtr + (i - numSpaces) * bytesPerColumn);
+			if (colData != 0)
 			{
-				setXY(textXpos, textYpos, textXpos, textYpos + ySize - 1);
-				LCD_Write_Repeated_DATA16(bcolour, ySize);
+				lastCharColData = colData & cmask;
 			}
-			++textXpos;
-			--numSpaces;
 		}
+		textXpos += numCellCols;
 	}
-
-    while (nCols != 0 && textXpos < textRightMargin)
-    {
-		uint32_t colData = *(uint32_t*)(fontPtr);
-		fontPtr += bytesPerColumn;
-		if (colData != 0)
+	else
+	{
+		// Transparent text, or text below the bottom of the display. Space columns leave the background alone, and we only write the foreground pixels.
+		while (numSpaces != 0 && textXpos < textRightMargin)
 		{
-			lastCharColData = colData & cmask;
+			++textXpos;
+			--numSpaces;
 		}
-		if (ySize != 0)
+
+		while (nCols != 0 && textXpos < textRightMargin)
 		{
-			bool doSetXY = true;
-			if (orient & InvertText)
+			uint32_t colData = *(uint32_t*)(fontPtr);
+			fontPtr += bytesPerColumn;
+			if (colData != 0)
 			{
-				uint32_t mask = 1u << (ySize - 1);
-				for (uint8_t i = 0; i < ySize; ++i)
+				lastCharColData = colData & cmask;
+			}
+			if (ySize != 0)
+			{
+				bool doSetXY = true;
+				if (orient & InvertText)
 				{
-					if (colData & mask)
+					uint32_t mask = 1u << (ySize - 1);
+					for (uint8_t i = 0; i < ySize; ++i)
 					{
-						if (doSetXY)
+						if (colData & mask)
 						{
-							setXY(textXpos, textYpos, textXpos, textYpos + ySize - i - 1);
-							doSetXY = false;
+							if (doSetXY)
+							{
+								setXY(textXpos, textYpos, textXpos, textYpos + ySize - i - 1);
+								doSetXY = false;
+							}
+							LCD_Write_DATA16(fcolour);
 						}
-						LCD_Write_DATA16(fcolour);
-					}
-					else if (transparentBackground)
-					{
-						doSetXY = true;
-					}
-					else
-					{
-						if (doSetXY)
+						else
 						{
-							setXY(textXpos, textYpos, textXpos, textYpos + ySize - i - 1);
-							doSetXY = false;
+							doSetXY = true;
 						}
-						LCD_Write_DATA16(bcolour);
+						colData <<= 1;
 					}
-					colData <<= 1;
 				}
-			}
-			else
-			{
-				for (uint8_t i = 0; i < ySize; ++i)
+				else
 				{
-					if (colData & 1u)
+					for (uint8_t i = 0; i < ySize; ++i)
 					{
-						if (doSetXY)
+						if (colData & 1u)
 						{
-							setXY(textXpos, textYpos + i, textXpos, textYpos + ySize - 1);
-							doSetXY = false;
+							if (doSetXY)
+							{
+								setXY(textXpos, textYpos + i, textXpos, textYpos + ySize - 1);
+								doSetXY = false;
+							}
+							LCD_Write_DATA16(fcolour);
 						}
-						LCD_Write_DATA16(fcolour);
-					}
-					else if (transparentBackground)
-					{
-						doSetXY = true;
-					}
-					else
-					{
-						if (doSetXY)
+						else
 						{
-							setXY(textXpos, textYpos + i, textXpos, textYpos + ySize - 1);
-							doSetXY = false;
+							doSetXY = true;
 						}
-						LCD_Write_DATA16(bcolour);
+						colData >>= 1;
 					}
-					colData >>= 1;
 				}
 			}
+			--nCols;
+			++textXpos;
 		}
-		--nCols;
-		++textXpos;
-    }
+	}
  	removeCS();
 	return 1;
 }
 
+// Draw a cell of opaque text at the current text position: numSpaces blank columns followed by the columns of the character, numCols in all.
+// We set one window for the whole cell and send its pixels in the order that the display fills the window, which depends on the orientation.
+// Pixels of the same colour that are next to each other in that order are sent together.
+void UTFT::writeOpaqueCell(const uint8_t *glyph, uint8_t numSpaces, uint16_t numCols, uint8_t bytesPerColumn, uint8_t ySize)
+{
+	setXY(textXpos, textYpos, textXpos + numCols - 1, textYpos + ySize - 1);
+
+	// setXY swaps X and Y in software, so with SwapXY the display fills each of our columns before moving on to the next one.
+	// Any reversal still done in software reverses the order too.
+	const bool byColumns = (orient & SwapXY) != 0;
+	const uint16_t numOuter = (byColumns) ? numCols : ySize;
+	const uint16_t numInner = (byColumns) ? ySize : numCols;
+	uint16_t runColour = bcolour;
+	uint32_t runLength = 0;
+	for (uint16_t outer = 0; outer < numOuter; ++outer)
+	{
+		for (uint16_t inner = 0; inner < numInner; ++inner)
+		{
+			uint16_t col = (byColumns) ? outer : inner;
+			uint16_t row = (byColumns) ? inner : outer;
+			if (orient & ReverseX)
+			{
+				col = numCols - 1 - col;
+			}
+			if (orient & ReverseY)
+			{
+				row = ySize - 1 - row;
+			}
+			const uint32_t colData = (col < numSpaces) ? 0 : *(uint32_t*)(glyph + (col - numSpaces) * bytesPerColumn);
+			const uint16_t colour = (colData & (1u << row)) ? fcolour : bcolour;
+			if (colour != runColour)
+			{
+				if (runLength != 0)
+				{
+					LCD_Write_Repeated_DATA16(runColour, runLength);
+				}
+				runColour = colour;
+				runLength = 0;
+			}
+			++runLength;
+		}
+	}
+	if (runLength != 0)
+	{
+		LCD_Write_Repeated_DATA16(runColour, runLength);
+	}
+}
+
 void UTFT::setFont(const uint8_t* font)
 {
 	cfont.x_size = font[0];
@@ -2140,6 +2198,102 @@ void UTFT::setFont(const uint8_t* font)
 	cfont.font = font + 8;
 }
 
+const size_t MaxFontMetrics = 4;
+static const FontMetrics *fontMetrics[MaxFontMetrics];
+static size_t numFontMetrics = 0;
+
+// Register the metrics for a font, so that text in that font can be measured without printing it
+/*static*/ void UTFT::AddFontMetrics(const FontMetrics& fm)
+{
+	if (GetFontMetrics(fm.font) == nullptr && numFontMetrics < MaxFontMetrics)
+	{
+		fontMetrics[numFontMetrics++] = &fm;
+	}
+}
+
+/*static*/ const FontMetrics* UTFT::GetFontMetrics(const uint8_t *f)
+{
+	for (size_t i = 0; i < numFontMetrics; ++i)
+	{
+		if (fontMetrics[i]->font == f)
+		{
+			return fontMetrics[i];
+		}
+	}
+	return nullptr;
+}
+
+TextMeasurer::TextMeasurer(const FontMetrics& fm, uint16_t rm)
+	: metrics(fm), header(reinterpret_cast<const FontDescriptor*>(fm.font)), textXpos(0), textRightMargin(rm), lastCharColData(0)
+{
+}
+
+int TextMeasurer::printf(const char* fmt, ...) noexcept
+{
+	va_list vargs;
+	va_start(vargs, fmt);
+	int ret = vuprintf([this](char c) -> bool
+						{
+							if (c == '\n')
+							{
+								return false;
+							}
+							if (c != 0)
+							{
+								write(c);
+							}
+							return true;
+						},
+						fmt,
+						vargs
+					  );
+	va_end(vargs);
+	return ret;
+}
+
+size_t TextMeasurer::write(uint8_t c)
+{
+	uint16_t ch;
+	if (decoder.Decode(c, ch))
+	{
+		writeNative(ch);
+	}
+	return 1;
+}
+
+// Advance the text position over a character in the same way as UTFT::writeNative, including the auto-kerning
+void TextMeasurer::writeNative(uint16_t c)
+{
+	if (c < header->firstChar || c > header->lastChar || c - header->firstChar >= metrics.numChars)
+	{
+		c = 0x007F;			// replace unsupported characters by square box
+	}
+	const CharMetrics& cm = metrics.chars[c - header->firstChar];
+
+	uint8_t numSpaces = 0;
+	if (lastCharColData != 0)
+	{
+		numSpaces = header->spaces;
+		const bool kern = (numSpaces >= 2)
+						? ((cm.firstColumn & lastCharColData) == 0)
+						: (((cm.firstColumn | (cm.firstColumn << 1)) & (lastCharColData | (lastCharColData << 1))) == 0);
+		if (kern)
+		{
+			--numSpaces;
+		}
+	}
+
+	if (textXpos < textRightMargin)
+	{
+		// If the character doesn't fit then everything after it is beyond the margin too, so it doesn't matter that we remember the kerning data for the whole character
+		textXpos += std::min<uint16_t>(numSpaces + cm.width, textRightMargin - textXpos);
+		if (!cm.blank)
+		{
+			lastCharColData = cm.lastColumn;
+		}
+	}
+}
+
 // Draw a bitmap using 16-bit colours
 void UTFT::drawBitmap16(int x, int y, int sx, int sy, const uint16_t * data, int scale, bool byCols)
 {
@@ -2224,28 +2378,39 @@ void UTFT::drawBitmap4(int x, int y, int sx, int sy, const uint8_t * data, Palet
 }
 
 // Draw a compressed bitmap. Data comprises alternate (repeat count - 1, data to write) pairs, both as 16-bit values.
+// The bitmap is stored a column at a time. All the pixels in a run have the same colour, so whatever order the display fills a window in,
+// we can set a window for the part of the run that is in the current column and send the colour once.
+// Where the orientation lets us write down a column, we set one window for the whole column and send the runs one after another.
 void UTFT::drawCompressedBitmap(int x, int y, int sx, int sy, const uint16_t *data)
 {
 	uint32_t count = 0;
 	uint16_t col = 0;
 	sx += x;
 	sy += y;
+	const bool wholeColumns = (orient & (ReverseY | SwapXY)) == 0;
 	assertCS();
 	for (int tx = x; tx < sx; tx++)
 	{
-		for (int ty = y; ty < sy; ty++)
+		if (wholeColumns)
+		{
+			setXY(tx, y, tx, sy - 1);
+		}
+		int ty = y;
+		while (ty < sy)
 		{
 			if (count == 0)
 			{
-				count = *data++;
+				count = (*data++) + 1;
 				col = *data++;
 			}
-			else
+			const uint32_t thisCount = std::min<uint32_t>(count, sy - ty);
+			if (!wholeColumns)
 			{
-				--count;
+				setXY(tx, ty, tx, ty + thisCount - 1);
 			}
-			setXY(tx, ty, tx, ty);
-			LCD_Write_DATA16(col);
+			LCD_Write_Repeated_DATA16(col, thisCount);
+			count -= thisCount;
+			ty += thisCount;
 		}
 	}
 	removeCS();
@@ -2259,62 +2424,32 @@ void UTFT::drawCompressedBitmapBottomToTop(int x, int y, int sx, int sy, const u
 	sx += x;
 	sy += y;
 	assertCS();
+	const bool wholeRows = (orient & (ReverseX | SwapXY)) == 0;
 	for (int ty = sy; ty != 0; )
 	{
 		--ty;
-		if ((orient & (ReverseX | SwapXY)) == 0)
+		if (wholeRows)
 		{
 			// The orientation allows us to write pixels one after another, without resetting the pixel address between them
 			setXY(x, ty, sx - 1, ty);
-			for (int tx = x; tx < sx; tx++)
-			{
-				if (count == 0)
-				{
-					count = *data++;
-					col = *data++;
-				}
-				else
-				{
-					--count;
-				}
-				LCD_Write_DATA16(col);
-			}
 		}
-		else
+		int tx = x;
+		while (tx < sx)
 		{
-#if 0
-			// This algorithm is faster but results in a non-uniform speed
-			int tx = x;
-			while (tx < sx)
+			if (count == 0)
 			{
-				if (count == 0)
-				{
-					count = (*data++) + 1;
-					col = *data++;
-				}
-				const uint32_t thisCount = std::min<uint32_t>(count, sx - tx);
-				setXY(tx, ty, tx + thisCount - 1, ty);
-				LCD_Write_Repeated_DATA16(col, thisCount);
-				count -= thisCount;
-				tx += thisCount;
+				count = (*data++) + 1;
+				col = *data++;
 			}
-#else
-			// Original slow-but-steady algorithm
-			for (int tx = x; tx < sx; tx++)
+			const uint32_t thisCount = std::min<uint32_t>(count, sx - tx);
+			if (!wholeRows)
 			{
-				if (count == 0)
-				{
-					count = *data++;
-					col = *data++;
-				}
-				else
-				{
-					--count;
-				}
-				setXY(tx, ty, tx, ty);
-				LCD_Write_DATA16(col);
+				// Set a window for the part of the run in this row. The pixels in it are all the same colour, so the order they are written in doesn't matter.
+				setXY(tx, ty, tx + thisCount - 1, ty);
 			}
-#endif
+			LCD_Write_Repeated_DATA16(col, thisCount);
+			count -= thisCount;
+			tx += thisCount;
 		}
 	}
 	removeCS();
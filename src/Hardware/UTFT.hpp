@@ -102,15 +102,73 @@ struct FontDescriptor
 	const uint8_t* font;
 };
 
+// Metrics for one character of a font, generated from the font by Tools/fontmetrics so that text can be measured without printing it
+struct CharMetrics
+{
+	uint32_t firstColumn;			// the column data that the auto-kerning compares with the previous character
+	uint32_t lastColumn;			// the column data that the auto-kerning compares with the next character
+	uint8_t width;					// number of columns, not counting the space columns before the character
+	bool blank;						// true if the character has no pixels set, so it leaves the previous character's column data to kern against
+};
+
+struct FontMetrics
+{
+	const uint8_t* font;			// the font these are the metrics for
+	const CharMetrics* chars;
+	uint16_t numChars;				// the number of characters in the font, which may be fewer than lastChar - firstChar + 1
+};
+
+// Decoder for UTF-8 text that is received a byte at a time
+class Utf8Decoder
+{
+public:
+	Utf8Decoder() : charVal(0), numContinuationBytesLeft(0) { }
+
+	// Add a byte, returning true and setting c if it completes a character. Invalid sequences and characters beyond 0xFFFF are returned as 0x7F.
+	bool Decode(uint8_t b, uint16_t& c);
+
+private:
+	uint32_t charVal;
+	uint8_t numContinuationBytesLeft;
+};
+
+// Somewhere text can be printed: the display, or a TextMeasurer that works out where the text would end without printing it
+class TextPrinter
+{
+public:
+	virtual size_t write(uint8_t c) = 0;							// write one byte of UTF-8 text
+	virtual int printf(const char* fmt, ...) noexcept = 0;			// stops at a newline character
+};
+
+// Lays out text from the start of a line in the way that UTFT prints it, using the metrics of the font.
+// Nothing is drawn and the display state is not changed.
+class TextMeasurer : public TextPrinter
+{
+public:
+	TextMeasurer(const FontMetrics& fm, uint16_t rm);
+
+	size_t write(uint8_t c) override;
+	int printf(const char* fmt, ...) noexcept override;
+	uint16_t getTextX() const { return textXpos; }
+
+private:
+	void writeNative(uint16_t c);
+
+	const FontMetrics& metrics;
+	const FontDescriptor* header;
+	uint16_t textXpos, textRightMargin;
+	uint32_t lastCharColData;
+	Utf8Decoder decoder;
+};
 
 typedef uint16_t Colour;
 typedef const uint16_t *Palette;
 
-class UTFT
+class UTFT : public TextPrinter
 {
 public:
 	// Overridden base class virtual functions
-	size_t write(uint8_t c);
+	size_t write(uint8_t c) override;
 
 	UTFT(DisplayType model, unsigned int RS, unsigned int WR, unsigned int CS, unsigned int RST, unsigned int SER_LATCH = 0);
 	void InitLCD(DisplayOrientation po, bool is24bit, bool isER);
@@ -134,7 +192,7 @@ public:
 	// New print functions
 	void setTextPos(uint16_t x, uint16_t y, uint16_t rm = 9999);
 	void clearToMargin();
-	int printf(const char* fmt, ...) noexcept;
+	int printf(const char* fmt, ...) noexcept override;
 
 	void setFont(const uint8_t* font);
 	void drawBitmap16(int x, int y, int sx, int sy, const uint16_t *data, int scale = 1, bool byCols = true);
@@ -149,6 +207,8 @@ public:
 	uint16_t getTextY() const { return textYpos; }
 	uint16_t getFontHeight() const { return cfont.y_size; }
 	static uint16_t GetFontHeight(const uint8_t *f) { return reinterpret_cast<const FontDescriptor*>(f)->y_size; }
+	static void AddFontMetrics(const FontMetrics& fm);
+	static const FontMetrics* GetFontMetrics(const uint8_t *f);		// returns nullptr if we don't have metrics for the font
 
 private:
 	uint16_t fcolour, bcolour;
@@ -164,10 +224,10 @@ private:
 	uint16_t textXpos, textYpos, textRightMargin;
 	uint32_t lastCharColData;		// used for auto kerning
 
-	uint32_t charVal;
-	uint8_t numContinuationBytesLeft;
+	Utf8Decoder decoder;
 
 	size_t writeNative(uint16_t c);
+	void writeOpaqueCell(const uint8_t *glyph, uint8_t numSpaces, uint16_t numCols, uint8_t bytesPerColumn, uint8_t ySize);
 	void applyGradient(uint16_t grad);
 
 	// Hardware interface
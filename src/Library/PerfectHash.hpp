@@ -0,0 +1,192 @@
+/*
+ * PerfectHash.hpp
+ *
+ * Created: 16/10/2026 10:13:31
+ *  Author: agent
+ *
+ * Hash tables for looking up fixed sets of strings such as object model field paths.
+ * The table is built by the compiler, so there is no sorting at startup and a lookup costs one hash and two array reads.
+ */
+
+#ifndef SRC_LIBRARY_PERFECTHASH_HPP_
+#define SRC_LIBRARY_PERFECTHASH_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+// FNV-1a hash of a string. Setting bit 5 of each character folds letters to lower case, so that lookups are case-insensitive
+// like the strcasecmp calls they replace. The characters we use in field paths (letters, digits, ':', '^', '_') never clash when folded.
+constexpr uint32_t StringHashInit = 2166136261u;
+
+constexpr uint32_t StringHashAdd(uint32_t hash, char c)
+{
+	return (hash ^ (uint8_t)(c | 0x20)) * 16777619u;
+}
+
+constexpr uint32_t StringHash(const char *s, uint32_t hash = StringHashInit)
+{
+	while (*s != 0)
+	{
+		hash = StringHashAdd(hash, *s++);
+	}
+	return hash;
+}
+
+template<class T> struct HashTableEntry
+{
+	T val;
+	const char *key;
+};
+
+// Perfect hash table using the hash-and-displace method.
+// The low bits of the hash select a bucket, and each bucket has a displacement that is chosen to move all of its keys to free slots.
+// The constructor is constexpr, so declare the table constexpr and static_assert that IsValid() returns true.
+template<class T, size_t NumEntries, size_t NumBuckets, size_t NumSlots> class PerfectHashTable
+{
+	static_assert((NumBuckets & (NumBuckets - 1)) == 0 && (NumSlots & (NumSlots - 1)) == 0, "Bucket and slot counts must be powers of 2");
+	static_assert(NumSlots <= 256, "Displacements are stored in bytes");
+	static_assert(NumEntries <= NumSlots, "Not enough slots");
+
+public:
+	constexpr PerfectHashTable(const HashTableEntry<T> (&entries)[NumEntries], T notFound);
+
+	// Construct a table that maps each of the given key hashes to the same value, for use as a set
+	constexpr PerfectHashTable(const uint32_t *hashes, T val, T notFound);
+
+	constexpr bool IsValid() const { return valid; }
+
+	// Look up a key given its hash. Keys that are not in the table return the notFound value.
+	T Find(uint32_t hash) const
+	{
+		const Slot& s = slots[SlotNumber(hash, displacements[hash & (NumBuckets - 1)])];
+		return (s.hash == hash) ? s.val : notFoundVal;
+	}
+
+	T Find(const char *key) const { return Find(StringHash(key)); }
+
+private:
+	struct Slot
+	{
+		uint32_t hash;
+		T val;
+	};
+
+	// Mix the displacement into the hash so that two keys in the same bucket are separated by most displacements
+	static constexpr size_t SlotNumber(uint32_t hash, uint8_t displacement)
+	{
+		return (((hash ^ (displacement * 0x9E3779B9u)) * 0x85EBCA6Bu) >> 24) & (NumSlots - 1);
+	}
+
+	constexpr void Build(const uint32_t *hashes, const T *vals);
+
+	Slot slots[NumSlots] = {};
+	uint8_t displacements[NumBuckets] = {};
+	T notFoundVal;
+	bool valid = false;
+};
+
+template<class T, size_t NumEntries, size_t NumBuckets, size_t NumSlots>
+constexpr PerfectHashTable<T, NumEntries, NumBuckets, NumSlots>::PerfectHashTable(const HashTableEntry<T> (&entries)[NumEntries], T notFound)
+	: notFoundVal(notFound)
+{
+	uint32_t hashes[NumEntries] = {};
+	T vals[NumEntries] = {};
+	for (size_t i = 0; i < NumEntries; ++i)
+	{
+		hashes[i] = StringHash(entries[i].key);
+		vals[i] = entries[i].val;
+	}
+	Build(hashes, vals);
+}
+
+template<class T, size_t NumEntries, size_t NumBuckets, size_t NumSlots>
+constexpr PerfectHashTable<T, NumEntries, NumBuckets, NumSlots>::PerfectHashTable(const uint32_t *hashes, T val, T notFound)
+	: notFoundVal(notFound)
+{
+	T vals[NumEntries] = {};
+	for (T& v : vals)
+	{
+		v = val;
+	}
+	Build(hashes, vals);
+}
+
+template<class T, size_t NumEntries, size_t NumBuckets, size_t NumSlots>
+constexpr void PerfectHashTable<T, NumEntries, NumBuckets, NumSlots>::Build(const uint32_t *hashes, const T *vals)
+{
+	size_t bucketSizes[NumBuckets] = {};
+	for (size_t i = 0; i < NumEntries; ++i)
+	{
+		++bucketSizes[hashes[i] & (NumBuckets - 1)];
+	}
+
+	// Empty slots hold the notFound value, so a lookup that lands on one fails whatever hash it holds
+	for (Slot& s : slots)
+	{
+		s.hash = 0;
+		s.val = notFoundVal;
+	}
+
+	// Place the buckets in order of decreasing size, because the big ones are the hardest to fit
+	bool used[NumSlots] = {};
+	bool bucketDone[NumBuckets] = {};
+	for (;;)
+	{
+		size_t bucket = NumBuckets;
+		for (size_t b = 0; b < NumBuckets; ++b)
+		{
+			if (!bucketDone[b] && bucketSizes[b] != 0 && (bucket == NumBuckets || bucketSizes[b] > bucketSizes[bucket]))
+			{
+				bucket = b;
+			}
+		}
+		if (bucket == NumBuckets)
+		{
+			break;
+		}
+		bucketDone[bucket] = true;
+
+		bool placed = false;
+		for (size_t d = 0; d < NumSlots && !placed; ++d)
+		{
+			// Try this displacement, and undo it if two keys land in the same slot
+			placed = true;
+			for (size_t i = 0; i < NumEntries; ++i)
+			{
+				if ((hashes[i] & (NumBuckets - 1)) == bucket)
+				{
+					const size_t slot = SlotNumber(hashes[i], d);
+					if (used[slot])
+					{
+						placed = false;
+						for (size_t j = 0; j < i; ++j)
+						{
+							if ((hashes[j] & (NumBuckets - 1)) == bucket)
+							{
+								const size_t s = SlotNumber(hashes[j], d);
+								used[s] = false;
+								slots[s].hash = 0;
+								slots[s].val = notFoundVal;
+							}
+						}
+						break;
+					}
+					used[slot] = true;
+					slots[slot].hash = hashes[i];
+					slots[slot].val = vals[i];
+				}
+			}
+			if (placed)
+			{
+				displacements[bucket] = (uint8_t)d;
+			}
+		}
+		if (!placed)
+		{
+			return;						// two keys have the same hash, or the table is too full
+		}
+	}
+	valid = true;
+}
+
+#endif /* SRC_LIBRARY_PERFECTHASH_HPP_ */
@@ -23,6 +23,7 @@
 #include "Hardware/SysTick.hpp"
 #include "Hardware/Reset.hpp"
 #include "Library/Misc.hpp"
+#include "Library/PerfectHash.hpp"
 #include "General/SafeStrtod.h"
 
 #if SAM4S
@@ -57,10 +58,25 @@ extern uint16_t _esplash[];							// defined in linker script
 #define DEBUG	(0)
 
 // Controlling constants
-constexpr uint32_t defaultPrinterPollInterval = 500;	// poll interval in milliseconds
-constexpr uint32_t defaultPrinterResponseInterval = defaultPrinterPollInterval * 0.7;		// shortest time after a response that we send another poll (gives printer time to catch up)
+constexpr uint32_t defaultPrinterPollInterval = 500;	// poll interval in milliseconds that we start with
+constexpr uint32_t minPrinterPollInterval = 150;		// shortest poll interval we will go down to when the printer keeps up
+constexpr uint32_t maxPrinterPollInterval = 4000;		// longest poll interval we will back off to when the printer doesn't keep up
+constexpr float printerResponseIntervalRatio = 0.7;		// shortest time after a response that we send another poll, as a fraction of the poll interval (gives printer time to catch up)
+constexpr uint32_t defaultPrinterResponseInterval = defaultPrinterPollInterval * printerResponseIntervalRatio;
+constexpr float pollRateIncrease = 0.1;				// polls per second added to the poll rate after each response that shows the printer is keeping up
+constexpr float pollRateDecrease = 0.5;				// factor that the poll rate is multiplied by when the printer runs out of buffers or doesn't respond
 constexpr uint32_t slowPrinterPollInterval = 4000;		// poll interval in milliseconds when screensaver active
+constexpr uint32_t subscribedPrinterPollInterval = 5000;	// poll interval in milliseconds while the printer pushes changes to us
 const uint32_t printerPollTimeout = 2000;			// poll timeout in milliseconds
+const uint32_t baudSwitchDelay = 100;				// how long we wait after M575 has been sent before changing our own baud rate, in milliseconds
+const uint32_t baudProbeTimeout = 3000;				// how long the link has at a new baud rate to prove itself, in milliseconds
+const unsigned int baudProbeResponses = 3;			// number of status responses that must arrive without errors at a new baud rate
+const unsigned int maxBaudFallbackAttempts = 3;		// how many times we ask the printer to go back to the last baud rate that worked
+const uint32_t connectBaudRateTimeout = 5000;		// shortest time we try one baud rate for before trying the other, in milliseconds
+const unsigned int connectUnansweredRequests = 2;	// number of status requests that must expire without any response before we try the other baud rate
+const size_t MaxStatusRequestsInFlight = 3;			// maximum number of status requests we send before their responses arrive
+const uint32_t BackgroundKeyDelay = 1000;			// how long a changed object model key that isn't on display waits before we fetch it, in milliseconds
+const uint32_t MaxKeyStaleness = 3000;				// how long any changed object model key waits at most, in milliseconds
 const uint32_t FileInfoRequestTimeout = 8000;		// file info request timeout in milliseconds
 const uint32_t touchBeepLength = 20;				// beep length in ms
 const uint32_t touchBeepFrequency = 4500;			// beep frequency in Hz. Resonant frequency of the piezo sounder is 4.5kHz.
@@ -117,20 +133,36 @@ UTouch touch(23, 24, 22, 21, 20);
 #define FETCH_TOOLS			(1)
 #define FETCH_VOLUMES		(1)
 
+// Set this to (1) to ask the host to send status responses in the compact encoding that SerialIo describes.
+// Hosts that don't support it ignore the extra flag and reply in JSON, which we still accept.
+#define OFFER_COMPACT_STATUS	(0)
+
+// Set this to (1) to ask the host to push changes to us instead of waiting for us to poll for them. Once we have fetched everything we send
+// M409 K"seqs" with the extra flag 'p' and a list of the keys that we fetch. A host that supports it answers as usual, and from then on sends
+// a line such as {"seqs":{"move":12}} whenever one of those seqs values changes, along with any live values that have changed in the same form
+// as in the live status. When the first of these arrives we fetch changed keys as soon as we hear about them and only poll the live status
+// as a slow heartbeat. Hosts that don't support it ignore the flag and never push, so we carry on polling as before.
+#define OFFER_PUSH_SUBSCRIPTION	(0)
+
+#if OFFER_COMPACT_STATUS
+# define STATUS_FLAGS		"b"
+#else
+# define STATUS_FLAGS		""
+#endif
+
 MainWindow mgr;
 
 static uint32_t lastTouchTime;
 static uint32_t ignoreTouchTime;
 static uint32_t lastPollTime;
 static uint32_t lastResponseTime = 0;
-static uint32_t lastOutOfBufferResponse = 0;
-static uint8_t oobCounter = 0;
 static bool outOfBuffers = false;
 static uint32_t lastActionTime = 0;							// the last time anything significant happened
 static FirmwareFeatures firmwareFeatures = 0;
 static bool isDimmed = false;								// true if we have dimmed the display
 static bool screensaverActive = false;						// true if screensaver is active
 static bool isDelta = false;
+static bool kinematicsReceived = false;						// true once isDelta has been set from the kinematics name since we connected
 static size_t numAxes = MIN_AXES;
 static int32_t beepFrequency = 0, beepLength = 0;
 static uint32_t messageSeq = 0;
@@ -144,9 +176,35 @@ static int8_t lastTool = -1;
 static uint8_t mountedVolumesCounted = 0;
 static uint32_t remoteUpTime = 0;
 static bool initialized = false;
-static float pollIntervalMultiplier = 1.0;
+static bool subscriptionRequested = false;				// true if we have asked the printer to push changes to us since we connected
+static bool subscribed = false;							// true if the printer has started pushing changes to us
+static float pollRate = 1000.0/defaultPrinterPollInterval;			// polls per second when the screensaver isn't active
 static uint32_t printerPollInterval = defaultPrinterPollInterval;
 static uint32_t printerResponseInterval = defaultPrinterResponseInterval;
+static uint32_t lastPollBackoffTime = 0;
+static uint32_t lastStatusResponseTime = 0;
+static uint32_t lastStatusResponseCount = 0;			// the received character count at the end of the last status response
+static uint32_t parserErrorCount = 0;
+static uint32_t outOfBufferResponses = 0;
+
+enum class BaudState : uint8_t
+{
+	idle,					// waiting for a chance to try a higher baud rate
+	switching,				// we have asked the printer to change baud rate and are waiting to follow it
+	probing,				// we have changed baud rate and are checking that the link works
+	settled					// there is no higher baud rate to try, or the last one failed
+};
+
+static uint32_t currentBaudRate = DefaultBaudRate;		// the baud rate that the UART is running at
+static BaudState baudState = BaudState::idle;
+static uint32_t baudStateChangedAt = 0;
+static uint32_t baudTargetRate;							// the baud rate that we have asked the printer to change to
+static uint32_t baudGoodRate;							// the last baud rate that worked
+static uint32_t baudFailedRate;							// the baud rate that we are falling back from
+static uint32_t baudErrorsBefore;						// receive and parser errors when we started probing
+static unsigned int baudProbeCount;						// status responses received since we started probing
+static unsigned int baudFallbackAttempts;
+static unsigned int unansweredRequests = 0;				// status requests that have expired since we last received anything
 
 const ColourScheme *colours = &colourSchemes[0];
 
@@ -159,6 +217,7 @@ struct FlashData
 	// We now use a different magic value for each display size, to force the "touch the spot" screen to be displayed when you change the display size
 	static const uint32_t magicVal = 0x3AB63A50 + DISPLAY_TYPE;
 	static const uint32_t muggleVal = 0xFFFFFFFF;
+	static const uint32_t autoBaudRate = 0x80000000;	// set in baudRate if we negotiate a higher rate than the one the printer is configured for
 
 	uint32_t magic;
 	uint32_t baudRate;
@@ -177,7 +236,7 @@ struct FlashData
 	uint32_t screensaverTimeout;
 	uint8_t babystepAmountIndex;
 	uint16_t feedrate;
-	uint8_t padding[1];
+	uint8_t negotiatedBaudRateIndex;		// index into NegotiatedBaudRates of the rate we last negotiated, if autoBaudRate is set in baudRate
 	char dummy;								// must be at a multiple of 4 bytes from the start because flash is read/written in whole dwords
 
 	FlashData() : magic(muggleVal) { }
@@ -229,7 +288,8 @@ bool FlashData::operator==(const FlashData& other)
 		&& infoTimeout == other.infoTimeout
 		&& screensaverTimeout == other.screensaverTimeout
 		&& babystepAmountIndex == other.babystepAmountIndex
-		&& feedrate == other.feedrate;
+		&& feedrate == other.feedrate
+		&& negotiatedBaudRateIndex == other.negotiatedBaudRateIndex;
 }
 
 void FlashData::SetDefaults()
@@ -250,6 +310,7 @@ void FlashData::SetDefaults()
 	screensaverTimeout = DefaultScreensaverTimeout;
 	babystepAmountIndex = DefaultBabystepAmountIndex;
 	feedrate = DefaultFeedrate;
+	negotiatedBaudRateIndex = 0xFF;
 	magic = magicVal;
 }
 
@@ -427,15 +488,11 @@ enum ReceivedDataEvent
 	rcvVolumesMounted,
 };
 
-struct FieldTableEntry
-{
-	ReceivedDataEvent rde;
-	const char* varName;
-};
+typedef HashTableEntry<ReceivedDataEvent> FieldTableEntry;
 
-// The following tables will be sorted once on startup so entries can be better grouped for code maintenance
+// The following table is turned into a perfect hash table at compile time, so entries can be grouped for code maintenance
 // A '^' character indicates the position of an _ecv_array index, and a ':' character indicates the start of a sub-field name
-static FieldTableEntry fieldTable[] =
+static constexpr FieldTableEntry fieldTable[] =
 {
 	// M409 common fields
 	{ rcvKey, 							"key" },
@@ -559,8 +616,61 @@ static FieldTableEntry fieldTable[] =
 	{ rcvControlCommand,				"controlCommand" },
 };
 
-// This table must be kept in case-insensitive alphabetical order of the search string.
-const FieldTableEntry keyResponseTypeTable[] =
+static constexpr PerfectHashTable<ReceivedDataEvent, ARRAY_SIZE(fieldTable), 64, 256> fieldLookup(fieldTable, rcvUnknown);
+static_assert(fieldLookup.IsValid(), "fieldTable has duplicate hashes; increase the number of slots or change the hash");
+
+// The parser skips the whole of any value whose path is neither in fieldTable nor leads to a field that is.
+// So we also need the paths up to each separator in fieldTable, and the empty path that the contents of an M409 reply with no key go in.
+template<size_t MaxPaths> struct FieldPathList
+{
+	uint32_t hashes[MaxPaths];
+	size_t count;
+
+	constexpr void Add(uint32_t hash)
+	{
+		for (size_t i = 0; i < count; ++i)
+		{
+			if (hashes[i] == hash)
+			{
+				return;
+			}
+		}
+		if (count < MaxPaths)
+		{
+			hashes[count] = hash;
+		}
+		++count;						// so that overflow can be detected
+	}
+};
+
+constexpr size_t MaxFieldPaths = 2 * ARRAY_SIZE(fieldTable);
+
+constexpr FieldPathList<MaxFieldPaths> ListFieldPaths()
+{
+	FieldPathList<MaxFieldPaths> paths = {};
+	paths.Add(StringHashInit);
+	for (const FieldTableEntry& entry : fieldTable)
+	{
+		uint32_t hash = StringHashInit;
+		for (const char *p = entry.key; *p != 0; ++p)
+		{
+			if (*p == ':' || *p == '^')
+			{
+				paths.Add(hash);
+			}
+			hash = StringHashAdd(hash, *p);
+		}
+		paths.Add(hash);
+	}
+	return paths;
+}
+
+static constexpr FieldPathList<MaxFieldPaths> fieldPaths = ListFieldPaths();
+static_assert(fieldPaths.count <= MaxFieldPaths, "Too many field paths; increase MaxFieldPaths");
+static constexpr PerfectHashTable<bool, fieldPaths.count, 64, 256> fieldPathLookup(fieldPaths.hashes, true, false);
+static_assert(fieldPathLookup.IsValid(), "field paths have duplicate hashes; increase the number of slots or change the hash");
+
+static constexpr FieldTableEntry keyResponseTypeTable[] =
 {
 	{ rcvOMKeyNoKey, 			"" },
 	{ rcvOMKeyBoards,			"boards" },
@@ -582,8 +692,34 @@ const FieldTableEntry keyResponseTypeTable[] =
 	{ rcvOMKeyVolumes,			"volumes" },
 };
 
+static constexpr PerfectHashTable<ReceivedDataEvent, ARRAY_SIZE(keyResponseTypeTable), 8, 64> keyResponseTypeLookup(keyResponseTypeTable, rcvUnknown);
+static_assert(keyResponseTypeLookup.IsValid(), "keyResponseTypeTable has duplicate hashes; increase the number of slots or change the hash");
+
+// Return the response type for a key given to M409, which may be a path within a top-level key such as "move.axes"
+static ReceivedDataEvent GetKeyResponseType(const char * _ecv_array key)
+{
+	uint32_t hash = StringHashInit;
+	while (*key != 0 && *key != '.')
+	{
+		hash = StringHashAdd(hash, *key++);
+	}
+	return keyResponseTypeLookup.Find(hash);
+}
+
+// Return the hash of the path to the result of M409 with the given key. The parser separates the names in a path with ':' where M409 uses '.'.
+static uint32_t GetKeyPathHash(const char * _ecv_array key)
+{
+	uint32_t hash = StringHashInit;
+	for (; *key != 0; ++key)
+	{
+		hash = StringHashAdd(hash, (*key == '.') ? ':' : *key);
+	}
+	return hash;
+}
 
 static ReceivedDataEvent currentResponseType = rcvUnknown;
+static uint32_t currentResponsePath = StringHashInit;		// the hash of the key path of the current response
+static bool currentResponseIsPartial = false;				// true if the current response is only part of a key that we sometimes fetch in full
 
 struct Seqs
 {
@@ -649,6 +785,28 @@ struct Seqs
 		updateTools 		=
 		updateVolumes 		= false;
 	}
+
+	bool IsUpdatePending(ReceivedDataEvent key) const noexcept
+	{
+		switch (key)
+		{
+		case rcvOMKeyBoards:		return updateBoards;
+		case rcvOMKeyDirectories:	return updateDirectories;
+		case rcvOMKeyFans:			return updateFans;
+		case rcvOMKeyHeat:			return updateHeat;
+		case rcvOMKeyInputs:		return updateInputs;
+		case rcvOMKeyJob:			return updateJob;
+		case rcvOMKeyMove:			return updateMove;
+		case rcvOMKeyNetwork:		return updateNetwork;
+		case rcvOMKeyScanner:		return updateScanner;
+		case rcvOMKeySensors:		return updateSensors;
+		case rcvOMKeySpindles:		return updateSpindles;
+		case rcvOMKeyState:			return updateState;
+		case rcvOMKeyTools:			return updateTools;
+		case rcvOMKeyVolumes:		return updateVolumes;
+		default:					return false;
+		}
+	}
 } seqs;
 
 struct OMRequestParams {
@@ -664,74 +822,191 @@ static const OMRequestParams heatParams =			{"heat"};
 static const OMRequestParams inputsParams =			{"inputs"};
 static const OMRequestParams jobParams =			{"job"};
 static const OMRequestParams moveParams =			{"move"};
+static const OMRequestParams moveAxesParams =		{"move.axes"};
 static const OMRequestParams networkParams =		{"network"};
 static const OMRequestParams scannerParams =		{"scanner"};
-static const OMRequestParams sensorsParams =		{"sensors"};
+static const OMRequestParams seqsParams =			{"seqs", "vp"};			// the 'p' asks the host to push changes to the seqs values
+static const OMRequestParams sensorsParams =		{"sensors.probes"};		// the probe values are all we use from sensors
 static const OMRequestParams spindlesParams =		{"spindles"};
 static const OMRequestParams stateParams =			{"state", "vn"};
 static const OMRequestParams toolsParams =			{"tools"};
 static const OMRequestParams volumesParams =		{"volumes"};
 
-const OMRequestParams* GetNextToPoll()
+// Status requests that we are waiting for responses to, oldest first. The printer answers them in the order we sent them.
+struct StatusRequest
 {
-	if (seqs.updateNetwork)
-	{
-		return &networkParams;
-	}
-	if (seqs.updateBoards)
-	{
-		return &boardsParams;
-	}
-	if (seqs.updateMove)
-	{
-		return &moveParams;
-	}
-	if (seqs.updateHeat)
-	{
-		return &heatParams;
-	}
-	if (seqs.updateTools)
-	{
-		return &toolsParams;
-	}
-	if (seqs.updateSpindles)
-	{
-		return &spindlesParams;
-	}
-	if (seqs.updateDirectories)
-	{
-		return &directoriesParams;
-	}
-	if (seqs.updateFans)
+	const OMRequestParams * null params;		// null for a request for the live status
+	ReceivedDataEvent responseType;				// what currentResponseType will be set to when the response arrives
+	uint32_t sentAt;
+	uint32_t receivedCount;						// the received character count when we sent it
+};
+
+static StatusRequest statusRequests[MaxStatusRequestsInFlight];
+static size_t numStatusRequests = 0;
+static size_t statusRequestWindow = MaxStatusRequestsInFlight;		// how many we let be in flight at the moment
+
+static bool IsStatusRequestOutstanding(ReceivedDataEvent responseType)
+{
+	for (size_t i = 0; i < numStatusRequests; ++i)
 	{
-		return &fansParams;
+		if (statusRequests[i].responseType == responseType)
+		{
+			return true;
+		}
 	}
-	if (seqs.updateInputs)
+	return false;
+}
+
+// The keys that we fetch when their seqs values change. When nothing else decides between them, we fetch them in this order.
+struct PollKey
+{
+	ReceivedDataEvent key;
+	const OMRequestParams& params;
+	bool fetched;							// false if we ignore changes to this key
+};
+
+static const PollKey pollKeys[] =
+{
+	{ rcvOMKeyNetwork,		networkParams,		FETCH_NETWORK },
+	{ rcvOMKeyBoards,		boardsParams,		FETCH_BOARDS },
+	{ rcvOMKeyMove,			moveParams,			FETCH_MOVE },
+	{ rcvOMKeyHeat,			heatParams,			FETCH_HEAT },
+	{ rcvOMKeyTools,		toolsParams,		FETCH_TOOLS },
+	{ rcvOMKeySpindles,		spindlesParams,		FETCH_SPINDLES },
+	{ rcvOMKeyDirectories,	directoriesParams,	FETCH_DIRECTORIES },
+	{ rcvOMKeyFans,			fansParams,			FETCH_FANS },
+	{ rcvOMKeyInputs,		inputsParams,		FETCH_INPUTS },
+	{ rcvOMKeyJob,			jobParams,			FETCH_JOB },
+	{ rcvOMKeyScanner,		scannerParams,		FETCH_SCANNER },
+	{ rcvOMKeySensors,		sensorsParams,		FETCH_SENSORS },
+	{ rcvOMKeyState,		stateParams,		FETCH_STATE },
+	{ rcvOMKeyVolumes,		volumesParams,		FETCH_VOLUMES },
+};
+
+static uint32_t pollKeyPendingSince[ARRAY_SIZE(pollKeys)];	// when we first saw that each key needed fetching
+static uint16_t pollKeysPending = 0;						// bitmap of the keys that pollKeyPendingSince is valid for
+static uint16_t pollKeysPartial = 0;						// bitmap of the keys that we last fetched only part of
+static_assert(ARRAY_SIZE(pollKeys) <= 16, "pollKeysPending is too small");
+
+// Return what to ask for to fetch the given key for the given view. Where a view only shows part of a large key we fetch just that part,
+// because the size of the responses is what limits how often we can update the display.
+static const OMRequestParams& GetRequestParams(UI::DisplayedView view, const PollKey& pk)
+{
+	if (   pk.key == rcvOMKeyMove && kinematicsReceived
+		&& (view == UI::DisplayedView::control || view == UI::DisplayedView::jog)
+	   )
 	{
-		return &inputsParams;
+		return moveAxesParams;					// these show the axis positions and homed status, and need the kinematics only to set isDelta
 	}
-	if (seqs.updateJob)
+	return pk.params;
+}
+
+// Return true if a response with the given key is only part of what we fetch for that key on some views
+static bool IsPartialKey(ReceivedDataEvent responseType, const char * _ecv_array key)
+{
+	for (const PollKey& pk : pollKeys)
 	{
-		return &jobParams;
+		if (pk.key == responseType)
+		{
+			return strcmp(key, pk.params.key) != 0;
+		}
 	}
-	if (seqs.updateScanner)
+	return false;
+}
+
+// Record whether we have only fetched part of a key, so that we fetch the rest when a view that shows it is displayed
+static void SetKeyPartial(ReceivedDataEvent responseType, bool partial)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(pollKeys); ++i)
 	{
-		return &scannerParams;
+		if (pollKeys[i].key == responseType)
+		{
+			if (partial)
+			{
+				pollKeysPartial |= 1u << i;
+			}
+			else
+			{
+				pollKeysPartial &= ~(1u << i);
+			}
+			break;
+		}
 	}
-	if (seqs.updateSensors)
+}
+
+// Return how much the given view needs the given key. Keys that aren't on display get weight 1.
+static unsigned int GetPollWeight(UI::DisplayedView view, ReceivedDataEvent key)
+{
+	if (key == rcvOMKeyState)
 	{
-		return &sensorsParams;
+		return 2;								// the printer status and alerts are shown whatever the view
 	}
-	if (seqs.updateState)
+	switch (view)
 	{
-		return &stateParams;
+	case UI::DisplayedView::control:
+		return (key == rcvOMKeyHeat || key == rcvOMKeyTools || key == rcvOMKeyMove || key == rcvOMKeySpindles) ? 4 : 1;
+	case UI::DisplayedView::print:
+		return (key == rcvOMKeyJob || key == rcvOMKeyHeat || key == rcvOMKeyTools || key == rcvOMKeyFans) ? 4 : 1;
+	case UI::DisplayedView::jog:
+		return (key == rcvOMKeyMove) ? 4 : 1;
+	case UI::DisplayedView::offset:
+		return (key == rcvOMKeyMove || key == rcvOMKeyTools) ? 4 : 1;
+	case UI::DisplayedView::job:
+		return (key == rcvOMKeyJob || key == rcvOMKeyHeat) ? 4 : 1;
+	case UI::DisplayedView::fileList:
+		return (key == rcvOMKeyVolumes || key == rcvOMKeyDirectories) ? 4 : 1;
+	case UI::DisplayedView::macroList:
+		return (key == rcvOMKeyDirectories) ? 4 : 1;
+	default:
+		return 1;
 	}
-	if (seqs.updateVolumes)
+}
+
+// Return the next key to fetch out of those whose seqs values have changed and that we haven't already asked for, or null if there is none.
+// A key that we last fetched only part of also needs fetching if the current view shows more of it. Each one scores its weight for the
+// current view times how long it has been waiting, and the highest score wins. Once we are initialised, keys that aren't on display wait
+// at least BackgroundKeyDelay so that they don't hold up the live status polls, and any key that has waited MaxKeyStaleness outweighs
+// all the others.
+const OMRequestParams* GetNextToPoll()
+{
+	const uint32_t now = SystemTick::GetTickCount();
+	const UI::DisplayedView view = UI::GetDisplayedView();
+	const OMRequestParams *best = nullptr;
+	uint32_t bestScore = 0;
+	for (size_t i = 0; i < ARRAY_SIZE(pollKeys); ++i)
 	{
-		return &volumesParams;
-	}
+		const PollKey& pk = pollKeys[i];
+		const uint16_t bit = 1u << i;
+		const OMRequestParams& params = GetRequestParams(view, pk);
+		if (!seqs.IsUpdatePending(pk.key) && ((pollKeysPartial & bit) == 0 || &params != &pk.params))
+		{
+			pollKeysPending &= ~bit;
+			continue;
+		}
+		if ((pollKeysPending & bit) == 0)
+		{
+			pollKeyPendingSince[i] = now;
+			pollKeysPending |= bit;
+		}
+		if (IsStatusRequestOutstanding(pk.key))
+		{
+			continue;
+		}
 
-	return nullptr;
+		const uint32_t waited = min<uint32_t>(now - pollKeyPendingSince[i], 3600 * 1000);
+		const unsigned int weight = GetPollWeight(view, pk.key);
+		if (initialized && weight == 1 && waited < BackgroundKeyDelay)
+		{
+			continue;
+		}
+		const uint32_t score = ((waited >= MaxKeyStaleness) ? 16 : weight) * (waited + 1);
+		if (best == nullptr || score > bestScore)			// on a tie, the key earlier in the table wins
+		{
+			best = &params;
+			bestScore = score;
+		}
+	}
+	return best;
 }
 
 // Return the host firmware features
@@ -779,30 +1054,6 @@ bool PrintInProgress()
 	return IsPrintingStatus(status);
 }
 
-// Search an ordered table for a matching string
-ReceivedDataEvent bsearch(const FieldTableEntry _ecv_array table[], size_t numElems, const char* key)
-{
-	size_t low = 0u, high = numElems;
-	while (high > low)
-	{
-		const size_t mid = (high - low)/2 + low;
-		const int t = strcasecmp(key, table[mid].varName);
-		if (t == 0)
-		{
-			return table[mid].rde;
-		}
-		if (t > 0)
-		{
-			low = mid + 1u;
-		}
-		else
-		{
-			high = mid;
-		}
-	}
-	return (low < numElems && strcasecmp(key, table[low].varName) == 0) ? table[low].rde : rcvUnknown;
-}
-
 // Return true if sending a command or file list request to the printer now is a good idea.
 // We don't want to send these when the printer is busy with a previous command, because they will block normal status requests.
 bool OkToSend()
@@ -957,7 +1208,10 @@ void PortraitDisplay(const bool withTouch)
 void SetBaudRate(uint32_t rate)
 {
 	nvData.baudRate = rate;
+	currentBaudRate = rate;
 	SerialIo::Init(rate);
+	SerialIo::ReleaseTransmit();						// in case we were part way through changing baud rate automatically
+	baudState = BaudState::idle;
 }
 
 extern void SetBrightness(int percent)
@@ -974,8 +1228,208 @@ void UpdatePollRate()
 	}
 	else
 	{
-		printerPollInterval = defaultPrinterPollInterval * pollIntervalMultiplier;
-		printerResponseInterval = defaultPrinterResponseInterval * pollIntervalMultiplier;
+		printerPollInterval = (uint32_t)(1000.0f/pollRate);
+		if (subscribed)
+		{
+			printerPollInterval = max<uint32_t>(printerPollInterval, subscribedPrinterPollInterval);
+		}
+		printerResponseInterval = printerPollInterval * printerResponseIntervalRatio;
+	}
+}
+
+// The poll rate is adjusted in the same way as AIMD congestion control. While the printer answers polls well within the poll interval
+// we add a little to the rate, and when it runs out of buffers or doesn't answer we cut the rate. The time that the response spends
+// on the wire is not held against the printer, so a large response at a low baud rate doesn't count as the printer falling behind.
+
+// Several status requests may be in flight at once, up to statusRequestWindow. The window closes to one request when the poll rate is cut
+// and opens again one request at a time as responses show that the printer is keeping up.
+
+// Forget the oldest status requests
+static void RemoveStatusRequests(size_t count)
+{
+	numStatusRequests -= count;
+	for (size_t i = 0; i < numStatusRequests; ++i)
+	{
+		statusRequests[i] = statusRequests[i + count];
+	}
+}
+
+// Note that we have sent a status request, so that we can match up the response and time it
+static void AddStatusRequest(const OMRequestParams * null params)
+{
+	if (numStatusRequests == MaxStatusRequestsInFlight)
+	{
+		RemoveStatusRequests(1);						// we must have given up on the oldest one
+	}
+	StatusRequest& request = statusRequests[numStatusRequests++];
+	request.params = params;
+	request.responseType = (params == nullptr) ? rcvOMKeyNoKey : GetKeyResponseType(params->key);
+	request.sentAt = SystemTick::GetTickCount();
+	request.receivedCount = SerialIo::GetReceivedCount();
+}
+
+// Send a status request for the given key, or for the live status if params is null, and note when we sent it so that we can time the response.
+// If it wasn't queued because there was no room or an identical one is still waiting, there will be no response to it, so we don't note it.
+static void SendStatusRequest(const OMRequestParams * null params)
+{
+	SerialIo::SetCommandClass(SerialIo::CommandClass::statusPoll);
+	if (params == nullptr)
+	{
+		SerialIo::Sendf("M409 F\"d99f" STATUS_FLAGS "\"\n");
+	}
+	else
+	{
+		SerialIo::Sendf("M409 K\"%s\" F\"%s" STATUS_FLAGS "\"\n", params->key, params->flags);
+	}
+	if (SerialIo::WasLineQueued())
+	{
+		AddStatusRequest(params);
+	}
+}
+
+#if OFFER_PUSH_SUBSCRIPTION
+
+// Ask the printer to push changes to the seqs values of the keys that we fetch
+static void SendSubscriptionRequest()
+{
+	String<100> keys;
+	for (const PollKey& pk : pollKeys)
+	{
+		if (pk.fetched)
+		{
+			if (!keys.IsEmpty())
+			{
+				keys.cat(',');
+			}
+			for (const char *p = pk.params.key; *p != 0 && *p != '.'; ++p)
+			{
+				keys.cat(*p);
+			}
+		}
+	}
+	SerialIo::SetCommandClass(SerialIo::CommandClass::statusPoll);
+	SerialIo::Sendf("M409 K\"%s\" F\"%s\" P\"%s\"\n", seqsParams.key, seqsParams.flags, keys.c_str());
+	if (SerialIo::WasLineQueued())
+	{
+		AddStatusRequest(&seqsParams);
+		subscriptionRequested = true;					// else we try again the next time we would send a normal poll
+	}
+}
+
+#endif
+
+// Round trip times of status requests for each key, for the link diagnostics
+const uint32_t rttBucketLimits[] = { 50, 100, 200, 500, 1000, 2000 };		// upper limits of all but the last bucket, in milliseconds
+const size_t NumRttBuckets = ARRAY_SIZE(rttBucketLimits) + 1;
+
+struct RttHistogram
+{
+	ReceivedDataEvent key;
+	uint32_t counts[NumRttBuckets];
+};
+
+static RttHistogram rttHistograms[ARRAY_SIZE(pollKeys) + 2];		// the live status, seqs and each of the keys we fetch
+static size_t numRttHistograms = 0;
+
+static void RecordRoundTripTime(ReceivedDataEvent key, uint32_t roundTripTime)
+{
+	size_t i = 0;
+	while (i < numRttHistograms && rttHistograms[i].key != key)
+	{
+		++i;
+	}
+	if (i == numRttHistograms)
+	{
+		if (i == ARRAY_SIZE(rttHistograms))
+		{
+			return;
+		}
+		rttHistograms[i].key = key;
+		++numRttHistograms;
+	}
+
+	size_t bucket = 0;
+	while (bucket < ARRAY_SIZE(rttBucketLimits) && roundTripTime > rttBucketLimits[bucket])
+	{
+		++bucket;
+	}
+	++rttHistograms[i].counts[bucket];
+}
+
+// Called when we have received the complete response to a status request
+static void PollResponseReceived(const StatusRequest& request)
+{
+	// If the printer was still sending an earlier response when we sent this request, time it from the end of that response
+	// so that we don't count the time the printer spent on the earlier one
+	uint32_t startTime = request.sentAt, startCount = request.receivedCount;
+	if ((int32_t)(lastStatusResponseTime - startTime) > 0)
+	{
+		startTime = lastStatusResponseTime;
+		startCount = lastStatusResponseCount;
+	}
+	lastStatusResponseTime = SystemTick::GetTickCount();
+	lastStatusResponseCount = SerialIo::GetReceivedCount();
+
+	const uint32_t roundTripTime = lastStatusResponseTime - startTime;
+	RecordRoundTripTime(request.responseType, roundTripTime);
+	const uint32_t responseLength = lastStatusResponseCount - startCount;
+	const uint32_t wireTime = (responseLength * 10000)/currentBaudRate;		// 10 bits per character
+	const uint32_t printerTime = (roundTripTime > wireTime) ? roundTripTime - wireTime : 0;
+	if (printerTime * 2 <= printerPollInterval && wireTime * 2 <= printerPollInterval)
+	{
+		pollRate = min<float>(pollRate + pollRateIncrease, 1000.0f/minPrinterPollInterval);
+		UpdatePollRate();
+		if (statusRequestWindow < MaxStatusRequestsInFlight)
+		{
+			++statusRequestWindow;
+		}
+	}
+}
+
+// Called when the printer has run out of buffers or not answered a poll
+static void BackOffPollRate()
+{
+	statusRequestWindow = 1;
+	const uint32_t now = SystemTick::GetTickCount();
+	if (now - lastPollBackoffTime >= printerPollInterval)		// a burst of failures within one poll interval only counts once
+	{
+		pollRate = max<float>(pollRate * pollRateDecrease, 1000.0f/maxPrinterPollInterval);
+		UpdatePollRate();
+		lastPollBackoffTime = now;
+	}
+}
+
+// Called at the end of a response to a status request. Match it to the request by its key.
+// Responses come back in the order we sent the requests, so if there are older requests they will not be answered.
+// We don't need to ask for them again explicitly, because the seqs flags that made us send them are still set.
+static void StatusResponseReceived()
+{
+	for (size_t i = 0; i < numStatusRequests; ++i)
+	{
+		if (statusRequests[i].responseType == currentResponseType)
+		{
+			const StatusRequest request = statusRequests[i];
+			RemoveStatusRequests(i + 1);
+			PollResponseReceived(request);
+			++baudProbeCount;
+			return;
+		}
+	}
+}
+
+// Forget status requests that have not been answered in time, and back off
+static void ExpireStatusRequests(uint32_t now)
+{
+	size_t numExpired = 0;
+	while (numExpired < numStatusRequests && now - statusRequests[numExpired].sentAt >= printerPollTimeout)
+	{
+		++numExpired;
+	}
+	if (numExpired != 0)
+	{
+		RemoveStatusRequests(numExpired);
+		unansweredRequests += numExpired;
+		BackOffPollRate();
 	}
 }
 
@@ -1068,7 +1522,284 @@ bool SetLanguage(uint8_t newLanguage)
 
 uint32_t GetBaudRate()
 {
-	return nvData.baudRate;
+	return currentBaudRate;
+}
+
+// Automatic baud rate negotiation.
+// When it is enabled, nvData.baudRate holds the rate that the printer is configured for plus autoBaudRate. Once we are connected and the
+// printer is idle, we ask it with M575 to change to the next rate up that our UART can generate accurately, follow it, and keep the new rate
+// if the next few status responses arrive without framing or parser errors. Otherwise we ask the printer to go back to the last rate that
+// worked and stay there. The rate we settle on is saved, so we start at it next time. While we get no responses we alternate between it
+// and the configured rate, because either end may have restarted since we negotiated.
+
+bool IsAutoBaudRate()
+{
+	return (nvData.baudRate & FlashData::autoBaudRate) != 0;
+}
+
+static uint32_t GetConfiguredBaudRate()
+{
+	return nvData.baudRate & ~FlashData::autoBaudRate;
+}
+
+static uint8_t GetNegotiatedBaudRateIndex(uint32_t rate)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(NegotiatedBaudRates); ++i)
+	{
+		if (NegotiatedBaudRates[i] == rate)
+		{
+			return i;
+		}
+	}
+	return 0xFF;
+}
+
+// Return the baud rate to start at
+static uint32_t GetStartingBaudRate()
+{
+	return (IsAutoBaudRate() && nvData.negotiatedBaudRateIndex < ARRAY_SIZE(NegotiatedBaudRates))
+			? NegotiatedBaudRates[nvData.negotiatedBaudRateIndex]
+			: GetConfiguredBaudRate();
+}
+
+// Return the next rate above the given one that our UART can generate accurately, or 0 if there is none
+static uint32_t GetNextBaudRate(uint32_t rate)
+{
+	for (uint32_t r : NegotiatedBaudRates)
+	{
+		if (r > rate && SerialIo::IsBaudRateAccurate(r))
+		{
+			return r;
+		}
+	}
+	return 0;
+}
+
+void SetAutoBaudRate()
+{
+	nvData.baudRate = GetConfiguredBaudRate() | FlashData::autoBaudRate;
+	nvData.negotiatedBaudRateIndex = GetNegotiatedBaudRateIndex(currentBaudRate);
+	baudState = BaudState::idle;
+	baudStateChangedAt = SystemTick::GetTickCount();
+}
+
+// Change our baud rate, and send anything that was held back while the printer changed
+static void SwitchBaudRate(uint32_t rate)
+{
+	SerialIo::Init(rate);
+	SerialIo::ReleaseTransmit();
+	currentBaudRate = rate;
+}
+
+// Save the rate we have settled on, without saving any other settings that the user hasn't asked us to save
+static void SaveNegotiatedBaudRate(uint32_t rate)
+{
+	const uint8_t index = GetNegotiatedBaudRateIndex(rate);
+	if (index != nvData.negotiatedBaudRateIndex)
+	{
+		nvData.negotiatedBaudRateIndex = savedNvData.negotiatedBaudRateIndex = index;
+		while (Buzzer::Noisy()) { }
+		savedNvData.Save();
+	}
+}
+
+// Ask the printer to change baud rate. We follow it once the command has gone.
+// Anything else that is sent in the meantime is held back until then, because the printer may not understand it at either rate.
+static void RequestBaudRate(uint32_t rate, uint32_t now)
+{
+	SerialIo::Sendf("M575 P1 B%u S1\n", (unsigned int)rate);
+	SerialIo::HoldTransmit();
+	baudTargetRate = rate;
+	baudState = BaudState::switching;
+	baudStateChangedAt = now;
+}
+
+static void SpinBaudRate(uint32_t now)
+{
+	if (!IsAutoBaudRate())
+	{
+		return;
+	}
+
+	switch (baudState)
+	{
+	case BaudState::idle:
+	case BaudState::settled:
+		// We judge that the link is down from requests going unanswered, not from the time since the last response,
+		// because we poll slowly while the printer pushes changes to us and not at all while the Setup page is displayed
+		if (unansweredRequests >= connectUnansweredRequests && now - baudStateChangedAt >= connectBaudRateTimeout)
+		{
+			unansweredRequests = 0;
+			const uint32_t startingRate = GetStartingBaudRate();
+			if (startingRate != GetConfiguredBaudRate())
+			{
+				SwitchBaudRate((currentBaudRate == startingRate) ? GetConfiguredBaudRate() : startingRate);
+			}
+			baudState = BaudState::idle;
+			baudStateChangedAt = now;
+		}
+		else if (   baudState == BaudState::idle
+				 && initialized
+				 && now - lastResponseTime < printerPollTimeout
+				 && (status == PrinterStatus::idle || status == PrinterStatus::off)
+				)
+		{
+			const uint32_t nextRate = GetNextBaudRate(currentBaudRate);
+			if (nextRate == 0)
+			{
+				SaveNegotiatedBaudRate(currentBaudRate);
+				baudState = BaudState::settled;
+			}
+			else
+			{
+				baudGoodRate = currentBaudRate;
+				baudFallbackAttempts = 0;
+				RequestBaudRate(nextRate, now);
+			}
+		}
+		break;
+
+	case BaudState::switching:
+		if (!SerialIo::IsTransmitIdle())
+		{
+			baudStateChangedAt = now;
+		}
+		else if (now - baudStateChangedAt >= baudSwitchDelay)
+		{
+			SwitchBaudRate(baudTargetRate);
+			baudErrorsBefore = SerialIo::GetReceiveErrorCount() + parserErrorCount;
+			baudProbeCount = 0;
+			baudState = BaudState::probing;
+			baudStateChangedAt = now;
+			numStatusRequests = 0;					// the responses to these were lost in the change
+			SendStatusRequest(nullptr);
+			lastPollTime = now;
+		}
+		break;
+
+	case BaudState::probing:
+		if (SerialIo::GetReceiveErrorCount() + parserErrorCount != baudErrorsBefore || now - baudStateChangedAt >= baudProbeTimeout)
+		{
+			if (currentBaudRate != baudGoodRate)
+			{
+				baudFailedRate = currentBaudRate;
+				RequestBaudRate(baudGoodRate, now);
+			}
+			else if (++baudFallbackAttempts < maxBaudFallbackAttempts)
+			{
+				// The printer may not have heard us ask it to go back, so ask again at the rate it may still be at
+				SwitchBaudRate(baudFailedRate);
+				RequestBaudRate(baudGoodRate, now);
+			}
+			else
+			{
+				baudState = BaudState::settled;		// if the printer is still at the other rate, we will find it when we try to reconnect
+				baudStateChangedAt = now;
+			}
+		}
+		else if (baudProbeCount >= baudProbeResponses)
+		{
+			if (currentBaudRate == baudGoodRate)
+			{
+				SaveNegotiatedBaudRate(currentBaudRate);		// we have fallen back to it
+				baudState = BaudState::settled;
+			}
+			else
+			{
+				baudState = BaudState::idle;					// try the next one up
+			}
+			baudStateChangedAt = now;
+		}
+		break;
+	}
+}
+
+static const char * _ecv_array GetKeyName(ReceivedDataEvent key)
+{
+	if (key != rcvOMKeyNoKey)
+	{
+		for (const FieldTableEntry& entry : keyResponseTypeTable)
+		{
+			if (entry.val == key)
+			{
+				return entry.key;
+			}
+		}
+	}
+	return "live";
+}
+
+// Write one line of the link diagnostics report. Returns false if there is no such line.
+// The first few lines are the counters, then there is a header and one line per key for the round trip time histograms.
+// These lines are deliberately not translated, because SendLinkReport also sends them to the printer's log using M118,
+// where they are read alongside the printer's own English diagnostics.
+bool GetLinkReportLine(size_t index, const StringRef& s)
+{
+	const SerialIo::LinkCounters& counters = SerialIo::GetLinkCounters();
+	s.Clear();
+	switch (index)
+	{
+	case 0:
+		s.printf("RX %u bytes, %u lines", (unsigned int)counters.rxBytes, (unsigned int)counters.rxLines);
+		break;
+
+	case 1:
+		s.printf("TX %u bytes, %u lines", (unsigned int)counters.txBytes, (unsigned int)counters.txLines);
+		break;
+
+	case 2:
+		s.printf("Lost %u lines: %u overruns, %u framing errors",
+					(unsigned int)counters.linesLost, (unsigned int)counters.overrunErrors, (unsigned int)counters.framingErrors);
+		break;
+
+	case 3:
+		{
+			const SerialIo::CommandCounters& polls = SerialIo::GetCommandCounters(SerialIo::CommandClass::statusPoll);
+			s.printf("Out of buffers %u, polls merged %u, dropped %u",
+						(unsigned int)outOfBufferResponses, (unsigned int)polls.merged, (unsigned int)polls.dropped);
+		}
+		break;
+
+	case 4:
+		s.printf("Parse errors %u:", (unsigned int)counters.parseErrors);
+		SerialIo::ListParseErrors(s);
+		break;
+
+	case 5:
+		s.copy("RTT ms");
+		for (uint32_t limit : rttBucketLimits)
+		{
+			s.catf(" <%u", (unsigned int)limit);
+		}
+		s.cat(" more");
+		break;
+
+	default:
+		if (index - LinkReportHeaderLines >= numRttHistograms)
+		{
+			return false;
+		}
+		{
+			const RttHistogram& histogram = rttHistograms[index - LinkReportHeaderLines];
+			s.copy(GetKeyName(histogram.key));
+			for (uint32_t count : histogram.counts)
+			{
+				s.catf(" %u", (unsigned int)count);
+			}
+		}
+		break;
+	}
+	return true;
+}
+
+// Send the link diagnostics report to the printer, which echoes it to its console
+void SendLinkReport()
+{
+	String<MaxLinkReportLineLength> line;
+	for (size_t i = 0; GetLinkReportLine(i, line.GetRef()); ++i)
+	{
+		SerialIo::Sendf("M118 S\"PanelDue: %s\"\n", line.c_str());
+	}
 }
 
 uint32_t GetVolume()
@@ -1175,9 +1906,19 @@ void SetStatus(const char * sts)
 void Reconnect()
 {
 	initialized = false;
+	kinematicsReceived = false;							// the printer may have been reconfigured
+	if (baudState == BaudState::settled)
+	{
+		baudState = BaudState::idle;					// the printer may have restarted at a different baud rate
+	}
+	subscriptionRequested = subscribed = false;			// the printer may have restarted and forgotten that we asked it to push changes
 	SetStatus(nullptr);
-	// Send first round of data fetching again
-	SerialIo::Sendf("M409 F\"d99f\"\n");
+	// Start again from the default poll rate, and send first round of data fetching again
+	pollRate = 1000.0/defaultPrinterPollInterval;
+	UpdatePollRate();
+	numStatusRequests = 0;
+	statusRequestWindow = MaxStatusRequestsInFlight;
+	SendStatusRequest(nullptr);
 	// And set the last poll time to now
 	lastPollTime = SystemTick::GetTickCount();
 }
@@ -1218,6 +1959,55 @@ bool GetFloat(const char s[], float &rslt)
 	return *endptr == 0;					// we parsed a float
 }
 
+static constexpr uint32_t PowersOfTen[] = { 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000 };
+
+// Get an integer from a received value, rounding it if it has a fractional part. Only text and very long numbers need to be parsed.
+bool GetInteger(const ReceivedValue& val, int32_t &rslt)
+{
+	if (val.kind == ReceivedValue::Kind::integer || val.kind == ReceivedValue::Kind::fixedPoint)
+	{
+		const uint32_t scale = PowersOfTen[val.decimals];
+		uint32_t mag = val.magnitude/scale;
+		if ((val.magnitude % scale) * 2 >= scale)
+		{
+			++mag;								// round half away from zero, as the floating point version does
+		}
+		rslt = (int32_t)((val.negative) ? 0u - mag : mag);
+		return true;
+	}
+	return GetInteger(val.text, rslt);
+}
+
+// Get an unsigned integer from a received value
+bool GetUnsignedInteger(const ReceivedValue& val, uint32_t &rslt)
+{
+	if (val.kind == ReceivedValue::Kind::integer && !val.negative)
+	{
+		rslt = val.magnitude;
+		return true;
+	}
+	return GetUnsignedInteger(val.text, rslt);
+}
+
+// Get a floating point value from a received value. A fixed point number costs one conversion and one division instead of a strtof call.
+bool GetFloat(const ReceivedValue& val, float &rslt)
+{
+	if (val.kind == ReceivedValue::Kind::integer || val.kind == ReceivedValue::Kind::fixedPoint)
+	{
+		rslt = (float)val.magnitude;
+		if (val.decimals != 0)
+		{
+			rslt /= (float)PowersOfTen[val.decimals];
+		}
+		if (val.negative)
+		{
+			rslt = -rslt;
+		}
+		return true;
+	}
+	return GetFloat(val.text, rslt);
+}
+
 // Try to get a bool value from a string.
 bool GetBool(const char s[], bool &rslt)
 {
@@ -1244,6 +2034,7 @@ void SeqsRequestDone(const ReceivedDataEvent rde)
 	{
 		return;
 	}
+	SetKeyPartial(rde, currentResponseIsPartial);
 	switch (rde)
 	{
 	case rcvOMKeyBoards:
@@ -1298,9 +2089,22 @@ void EndReceivedMessage()
 {
 	ShowLine;
 	lastResponseTime = SystemTick::GetTickCount();
+	unansweredRequests = 0;
+	if (outOfBuffers)
+	{
+		if (numStatusRequests != 0)
+		{
+			RemoveStatusRequests(1);				// the printer couldn't answer the oldest request
+		}
+	}
+	else if (currentResponseType != rcvUnknown)
+	{
+		StatusResponseReceived();
+	}
 	SeqsRequestDone(currentResponseType);
 	outOfBuffers = false;							// Reset the out-of-buffers flag
 	currentResponseType = rcvUnknown;
+	currentResponseIsPartial = false;
 
 	if (newMessageSeq != messageSeq)
 	{
@@ -1322,6 +2126,15 @@ void EndReceivedMessage()
 
 void UpdateSeqs(const ReceivedDataEvent rde, const int32_t ival)
 {
+#if OFFER_PUSH_SUBSCRIPTION
+	// Seqs values that aren't part of a response to M409 mean that the printer has started pushing changes to us
+	if (currentResponseType == rcvUnknown && subscriptionRequested && !subscribed)
+	{
+		subscribed = true;
+		UpdatePollRate();
+	}
+#endif
+
 	switch (rde)
 	{
 #if FETCH_BOARDS
@@ -1477,6 +2290,8 @@ const OMRequestParams* GetOMRequestParams()
 		return &networkParams;
 	case rcvOMKeyScanner:
 		return &scannerParams;
+	case rcvOMKeySeqs:
+		return &seqsParams;
 	case rcvOMKeySensors:
 		return &sensorsParams;
 	case rcvOMKeySpindles:
@@ -1493,32 +2308,17 @@ const OMRequestParams* GetOMRequestParams()
 }
 
 void HandleOutOfBufferResponse() {
-
-	const uint32_t now = SystemTick::GetTickCount();
-
-	// We received the previous out-of-buffer within 10s
-	if (now - lastOutOfBufferResponse <= 10000) {
-		++oobCounter;
-	} else {
-		// Reset it if it was more than 10s ago - glitches happen
-		oobCounter = 0;
-	}
-
-	// Slow down the poll interval by 10% if we see too many out-of-buffer in short time
-	if (oobCounter >= 3) {
-		pollIntervalMultiplier += 0.1;
-		UpdatePollRate();
-		oobCounter = 0;
-		MessageLog::AppendMessage("Slowing down poll rate");
-	}
-	lastOutOfBufferResponse = now;
+	++outOfBufferResponses;
+	BackOffPollRate();
 	outOfBuffers = true;
 }
 
 // Public functions called by the SerialIo module
-void ProcessReceivedValue(StringRef id, const char data[], const size_t indices[])
+
+// Called when the name of a top-level field has been received. Returns the hash of the path to use in its place.
+uint32_t TranslateRootFieldId(uint32_t idHash)
 {
-	if (stringStartsWith(id.c_str(), "result"))
+	if (idHash == StringHash("result"))
 	{
 		auto requestParams = GetOMRequestParams();
 		if (requestParams != nullptr)
@@ -1526,29 +2326,33 @@ void ProcessReceivedValue(StringRef id, const char data[], const size_t indices[
 			// We might either get something like:
 			// * "result[optional modified]:[key]:[field]" for a live response or
 			// * "result[optional modified]:[field]" for a detailed response
-			// If live response remove "result:"
-			// else replace "result" by "key" (do NOT replace anything beyond "result" as there might be an _ecv_array modifier)
-
-			id.Erase(0, 6);		// Erase the string "result"
-			if (currentResponseType == rcvOMKeyNoKey)
-			{
-				id.Erase(0);	// Also erase the colon
-			}
-			else
-			{
-				id.Prepend(requestParams->key);		// Prepend the key of the current response
-			}
+			// If live response remove "result:" (the parser doesn't add a separator to an empty path)
+			// else replace "result" by the key path (the parser adds any array modifier after it)
+			return (currentResponseType == rcvOMKeyNoKey) ? StringHashInit : currentResponsePath;
 		}
 	}
+	return idHash;
+}
 
-	const ReceivedDataEvent rde = bsearch(fieldTable, ARRAY_SIZE(fieldTable), id.c_str());
+// Return true if we want the value at this path, or some of the fields inside it
+bool IsFieldIdWanted(uint32_t idHash)
+{
+	return fieldPathLookup.Find(idHash);
+}
+
+void ProcessReceivedValue(uint32_t idHash, const ReceivedValue& value, const size_t indices[])
+{
+	const char * const data = value.text;
+	const ReceivedDataEvent rde = fieldLookup.Find(idHash);
 	switch (rde)
 	{
 	// M409 section
 	case rcvKey:
 		ShowLine;
 		{
-			currentResponseType = bsearch(keyResponseTypeTable, ARRAY_SIZE(keyResponseTypeTable), data);
+			currentResponseType = GetKeyResponseType(data);
+			currentResponsePath = GetKeyPathHash(data);
+			currentResponseIsPartial = IsPartialKey(currentResponseType, data);
 			switch (currentResponseType) {
 			case rcvOMKeyHeat:
 				lastBed = -1;
@@ -1599,7 +2403,7 @@ void ProcessReceivedValue(StringRef id, const char data[], const size_t indices[
 		ShowLine;
 		{
 			float f;
-			bool b = GetFloat(data, f);
+			bool b = GetFloat(value, f);
 			if (b && f >= 0.0 && f <= 1.0)
 			{
 				UI::UpdateFanPercent(indices[0], (int)((f * 100.0f) + 0.5f));
@@ -1612,7 +2416,7 @@ void ProcessReceivedValue(StringRef id, const char data[], const size_t indices[
 		ShowLine;
 		{
 			int32_t heaterNumber;
-			if (GetInteger(data, heaterNumber) && heaterNumber > -1)
+			if (GetInteger(value, heaterNumber) && heaterNumber > -1)
 			{
 				UI::SetBedOrChamberHeater(indices[0], heaterNumber);
 				for (size_t i = lastBed + 1; i < indices[0]; ++i)
@@ -1628,7 +2432,7 @@ void ProcessReceivedValue(StringRef id, const char data[], const size_t indices[
 		ShowLine;
 		{
 			int32_t heaterNumber;
-			if (GetInteger(data, heaterNumber) && heaterNumber > -1)
+			if (GetInteger(value, heaterNumber) && heaterNumber > -1)
 			{
 				UI::SetBedOrChamberHeater(indices[0], heaterNumber, false);
 				for (size_t i = lastChamber + 1; i < indices[0]; ++i)
@@ -1644,7 +2448,7 @@ void ProcessReceivedValue(StringRef id, const char data[], const size_t indices[
 		ShowLine;
 		{
 			int32_t ival;
-			if (GetInteger(data, ival))
+			if (GetInteger(value, ival))
 			{
 				UI::UpdateActiveTemperature(indices[0], ival);
 			}
@@ -1655,7 +2459,7 @@ void ProcessReceivedValue(StringRef id, const char data[], const size_t indices[
 		ShowLine;
 		{
 			float fval;
-			if (GetFloat(data, fval))
+			if (GetFloat(value, fval))
 			{
 				ShowLine;
 				UI::UpdateCurrentTemperature(indices[0], fval);
@@ -1667,7 +2471,7 @@ void ProcessReceivedValue(StringRef id, const char data[], const size_t indices[
 		ShowLine;
 		{
 			int32_t ival;
-			if (GetInteger(data, ival))
+			if (GetInteger(value, ival))
 			{
 				UI::UpdateStandbyTemperature(indices[0], ival);
 			}
@@ -1703,7 +2507,7 @@ void ProcessReceivedValue(StringRef id, const char data[], const size_t indices[
 		ShowLine;
 		{
 			uint32_t ival;
-			if (GetUnsignedInteger(data, ival))
+			if (GetUnsignedInteger(value, ival))
 			{
 				fileSize = ival;
 			}
@@ -1720,7 +2524,7 @@ void ProcessReceivedValue(StringRef id, const char data[], const size_t indices[
 			if (PrintInProgress() && fileSize > 0)
 			{
 				uint32_t ival;
-				if (GetUnsignedInteger(data, ival))
+				if (GetUnsignedInteger(value, ival))
 				{
 					UI::SetPrintProgressPercent((unsigned int)(((ival*100.0f)/fileSize) + 0.5));
 				}
@@ -1751,7 +2555,7 @@ void ProcessReceivedValue(StringRef id, const char data[], const size_t indices[
 		ShowLine;
 		{
 			int32_t i;
-			bool b = GetInteger(data, i);
+			bool b = GetInteger(value, i);
 			if (b && i >= 0 && i < 10 * 24 * 60 * 60 && PrintInProgress())
 			{
 				UI::UpdateTimesLeft((rde == rcvJobTimesLeftFilament) ? 1 : (rde == rcvJobTimesLeftLayer) ? 2 : 0, i);
@@ -1764,7 +2568,7 @@ void ProcessReceivedValue(StringRef id, const char data[], const size_t indices[
 		ShowLine;
 		{
 			float f;
-			if (GetFloat(data, f))
+			if (GetFloat(value, f))
 			{
 				UI::SetBabystepOffset(indices[0], f);
 			}
@@ -1793,7 +2597,7 @@ void ProcessReceivedValue(StringRef id, const char data[], const size_t indices[
 		ShowLine;
 		{
 			float fval;
-			if (GetFloat(data, fval))
+			if (GetFloat(value, fval))
 			{
 				UI::UpdateAxisPosition(indices[0], fval);
 			}
@@ -1820,7 +2624,7 @@ void ProcessReceivedValue(StringRef id, const char data[], const size_t indices[
 		ShowLine;
 		{
 			float offset;
-			if (GetFloat(data, offset))
+			if (GetFloat(value, offset))
 			{
 				UI::SetAxisWorkplaceOffset(indices[0], indices[1], offset);
 			}
@@ -1831,7 +2635,7 @@ void ProcessReceivedValue(StringRef id, const char data[], const size_t indices[
 		ShowLine;
 		{
 			float fval;
-			if (GetFloat(data, fval))
+			if (GetFloat(value, fval))
 			{
 				UI::UpdateExtrusionFactor(indices[0], (int)((fval * 100.0f) + 0.5));
 			}
@@ -1843,6 +2647,7 @@ void ProcessReceivedValue(StringRef id, const char data[], const size_t indices[
 		if (status != PrinterStatus::configuring && status != PrinterStatus::connecting)
 		{
 			isDelta = (strcasecmp(data, "delta") == 0);
+			kinematicsReceived = true;
 			UI::UpdateGeometry(numAxes, isDelta);
 		}
 		break;
@@ -1851,7 +2656,7 @@ void ProcessReceivedValue(StringRef id, const char data[], const size_t indices[
 		ShowLine;
 		{
 			float fval;
-			if (GetFloat(data, fval))
+			if (GetFloat(value, fval))
 			{
 				UI::UpdateSpeedPercent((int) ((fval * 100.0f) + 0.5f));
 			}
@@ -1861,7 +2666,7 @@ void ProcessReceivedValue(StringRef id, const char data[], const size_t indices[
 	case rcvMoveWorkplaceNumber:
 		{
 			uint32_t workplaceNumber;
-			if (GetUnsignedInteger(data, workplaceNumber))
+			if (GetUnsignedInteger(value, workplaceNumber))
 			{
 				UI::SetCurrentWorkplaceNumber(workplaceNumber);
 			}
@@ -1906,7 +2711,7 @@ void ProcessReceivedValue(StringRef id, const char data[], const size_t indices[
 		ShowLine;
 		{
 			int32_t ival;
-			if (GetInteger(data, ival))
+			if (GetInteger(value, ival))
 			{
 				UpdateSeqs(rde, ival);
 			}
@@ -1928,7 +2733,7 @@ void ProcessReceivedValue(StringRef id, const char data[], const size_t indices[
 		ShowLine;
 		{
 			uint32_t active;
-			if (GetUnsignedInteger(data, active))
+			if (GetUnsignedInteger(value, active))
 			{
 				UI::SetSpindleActive(indices[0], active);
 			}
@@ -1945,7 +2750,7 @@ void ProcessReceivedValue(StringRef id, const char data[], const size_t indices[
 		ShowLine;
 		{
 			uint32_t current;
-			if (GetUnsignedInteger(data, current))
+			if (GetUnsignedInteger(value, current))
 			{
 				UI::SetSpindleCurrent(indices[0], current);
 			}
@@ -1961,7 +2766,7 @@ void ProcessReceivedValue(StringRef id, const char data[], const size_t indices[
 		}
 		{
 			uint32_t max;
-			if (GetUnsignedInteger(data, max))
+			if (GetUnsignedInteger(value, max))
 			{
 				UI::SetSpindleMax(indices[0], max);
 			}
@@ -1972,7 +2777,7 @@ void ProcessReceivedValue(StringRef id, const char data[], const size_t indices[
 		ShowLine;
 		{
 			int32_t toolNumber;
-			if (GetInteger(data, toolNumber))
+			if (GetInteger(value, toolNumber))
 			{
 				UI::SetSpindleTool(indices[0], toolNumber);
 			}
@@ -1988,7 +2793,7 @@ void ProcessReceivedValue(StringRef id, const char data[], const size_t indices[
 		}
 		{
 			int32_t tool;
-			if (GetInteger(data, tool))
+			if (GetInteger(value, tool))
 			{
 				UI::SetCurrentTool(tool);
 			}
@@ -2006,7 +2811,7 @@ void ProcessReceivedValue(StringRef id, const char data[], const size_t indices[
 
 	case rcvStateMessageBoxAxisControls:
 		ShowLine;
-		if (GetUnsignedInteger(data, currentAlert.controls))
+		if (GetUnsignedInteger(value, currentAlert.controls))
 		{
 			currentAlert.flags |= Alert::GotControls;
 		}
@@ -2020,7 +2825,7 @@ void ProcessReceivedValue(StringRef id, const char data[], const size_t indices[
 
 	case rcvStateMessageBoxMode:
 		ShowLine;
-		if (GetInteger(data, currentAlert.mode))
+		if (GetInteger(value, currentAlert.mode))
 		{
 			currentAlert.flags |= Alert::GotMode;
 		}
@@ -2028,7 +2833,7 @@ void ProcessReceivedValue(StringRef id, const char data[], const size_t indices[
 
 	case rcvStateMessageBoxSeq:
 		ShowLine;
-		if (GetUnsignedInteger(data, currentAlert.seq))
+		if (GetUnsignedInteger(value, currentAlert.seq))
 		{
 			currentAlert.flags |= Alert::GotSeq;
 		}
@@ -2036,7 +2841,7 @@ void ProcessReceivedValue(StringRef id, const char data[], const size_t indices[
 
 	case rcvStateMessageBoxTimeout:
 		ShowLine;
-		if (GetFloat(data, currentAlert.timeout))
+		if (GetFloat(value, currentAlert.timeout))
 		{
 			currentAlert.flags |= Alert::GotTimeout;
 		}
@@ -2059,7 +2864,7 @@ void ProcessReceivedValue(StringRef id, const char data[], const size_t indices[
 		ShowLine;
 		{
 			uint32_t uival;
-			if (GetUnsignedInteger(data, uival))
+			if (GetUnsignedInteger(value, uival))
 			{
 				// Controller was restarted
 				if (uival < remoteUpTime)
@@ -2084,7 +2889,7 @@ void ProcessReceivedValue(StringRef id, const char data[], const size_t indices[
 				return;
 			}
 			int32_t temp;
-			if (GetInteger(data, temp))
+			if (GetInteger(value, temp))
 			{
 				UI::UpdateToolTemp(indices[0], temp, rde == rcvToolsActive);
 			}
@@ -2099,7 +2904,7 @@ void ProcessReceivedValue(StringRef id, const char data[], const size_t indices[
 				return;
 			}
 			int32_t extruder;
-			if (GetInteger(data, extruder))
+			if (GetInteger(value, extruder))
 			{
 				UI::SetToolExtruder(indices[0], extruder);
 			}
@@ -2114,7 +2919,7 @@ void ProcessReceivedValue(StringRef id, const char data[], const size_t indices[
 				return;
 			}
 			int32_t fan;
-			if (GetInteger(data, fan))
+			if (GetInteger(value, fan))
 			{
 				UI::SetToolFan(indices[0], fan);
 			}
@@ -2129,7 +2934,7 @@ void ProcessReceivedValue(StringRef id, const char data[], const size_t indices[
 				return;
 			}
 			int32_t heater;
-			if (GetInteger(data, heater))
+			if (GetInteger(value, heater))
 			{
 				UI::SetToolHeater(indices[0], heater);
 			}
@@ -2151,7 +2956,7 @@ void ProcessReceivedValue(StringRef id, const char data[], const size_t indices[
 		ShowLine;
 		{
 			float offset;
-			if (GetFloat(data, offset))
+			if (GetFloat(value, offset))
 			{
 				UI::SetToolOffset(indices[0], indices[1], offset);
 			}
@@ -2209,17 +3014,17 @@ void ProcessReceivedValue(StringRef id, const char data[], const size_t indices[
 
 	case rcvPushSeq:
 		ShowLine;
-		GetUnsignedInteger(data, newMessageSeq);
+		GetUnsignedInteger(value, newMessageSeq);
 		break;
 
 	case rcvPushBeepDuration:
 		ShowLine;
-		GetInteger(data, beepLength);
+		GetInteger(value, beepLength);
 		break;
 
 	case rcvPushBeepFrequency:
 		ShowLine;
-		GetInteger(data, beepFrequency);
+		GetInteger(value, beepFrequency);
 		break;
 
 	// M20 section
@@ -2232,7 +3037,7 @@ void ProcessReceivedValue(StringRef id, const char data[], const size_t indices[
 		ShowLine;
 		{
 			int32_t i;
-			if (GetInteger(data, i))
+			if (GetInteger(value, i))
 			{
 				if (i >= 0)
 				{
@@ -2266,7 +3071,7 @@ void ProcessReceivedValue(StringRef id, const char data[], const size_t indices[
 				totalFilament = 0.0;
 			}
 			float f;
-			if (GetFloat(data, f))
+			if (GetFloat(value, f))
 			{
 				totalFilament += f;
 				UI::UpdateFileFilament((int)totalFilament);
@@ -2285,7 +3090,7 @@ void ProcessReceivedValue(StringRef id, const char data[], const size_t indices[
 		ShowLine;
 		{
 			float f;
-			if (GetFloat(data, f))
+			if (GetFloat(value, f))
 			{
 				UI::UpdateFileObjectHeight(f);
 			}
@@ -2301,7 +3106,7 @@ void ProcessReceivedValue(StringRef id, const char data[], const size_t indices[
 		ShowLine;
 		{
 			float f;
-			if (GetFloat(data, f))
+			if (GetFloat(value, f))
 			{
 				UI::UpdateFileLayerHeight(f);
 			}
@@ -2313,7 +3118,7 @@ void ProcessReceivedValue(StringRef id, const char data[], const size_t indices[
 		ShowLine;
 		{
 			int32_t sz;
-			if (GetInteger(data, sz) && sz > 0)
+			if (GetInteger(value, sz) && sz > 0)
 			{
 				UI::UpdatePrintTimeText((uint32_t)sz, rde == rcvM36SimulatedTime);
 			}
@@ -2324,7 +3129,7 @@ void ProcessReceivedValue(StringRef id, const char data[], const size_t indices[
 		ShowLine;
 		{
 			int32_t sz;
-			if (GetInteger(data, sz))
+			if (GetInteger(value, sz))
 			{
 				UI::UpdateFileSize(sz);
 			}
@@ -2368,63 +3173,87 @@ void ProcessReceivedValue(StringRef id, const char data[], const size_t indices[
 }
 
 // Public function called when the serial I/O module finishes receiving an array of values
-void ProcessArrayEnd(const char id[], const size_t indices[])
+void ProcessArrayEnd(uint32_t idHash, const size_t indices[])
 {
-	if (indices[0] == 0 && strcmp(id, "files^") == 0)
-	{
-		FileManager::BeginReceivingFiles();				// received an empty file list - need to tell the file manager about it
-	}
-	else if (currentResponseType == rcvOMKeyHeat)
+	switch (idHash)
 	{
-		if (strcasecmp(id, "heat:bedHeaters^") == 0)
+	case StringHash("files^"):
+		if (indices[0] == 0)
+		{
+			FileManager::BeginReceivingFiles();				// received an empty file list - need to tell the file manager about it
+		}
+		break;
+
+	case StringHash("heat:bedHeaters^"):
+		if (currentResponseType == rcvOMKeyHeat)
 		{
 			OM::RemoveBed(lastBed + 1, true);
 			UI::AllToolsSeen();
 		}
-		else if (strcasecmp(id, "heat:chamberHeaters^") == 0)
+		break;
+
+	case StringHash("heat:chamberHeaters^"):
+		if (currentResponseType == rcvOMKeyHeat)
 		{
 			OM::RemoveChamber(lastChamber + 1, true);
 			UI::AllToolsSeen();
 		}
-	}
-	else if (currentResponseType == rcvOMKeyMove && strcasecmp(id, "move:axes^") == 0)
-	{
-		OM::RemoveAxis(indices[0], true);
-		numAxes = constrain<unsigned int>(visibleAxesCounted, MIN_AXES, MaxTotalAxes);
-		UI::UpdateGeometry(numAxes, isDelta);
-	}
-	else if (currentResponseType == rcvOMKeySpindles)
-	{
-		if (strcasecmp(id, "spindles^") == 0)
+		break;
+
+	case StringHash("move:axes^"):
+		if (currentResponseType == rcvOMKeyMove)
+		{
+			OM::RemoveAxis(indices[0], true);
+			numAxes = constrain<unsigned int>(visibleAxesCounted, MIN_AXES, MaxTotalAxes);
+			UI::UpdateGeometry(numAxes, isDelta);
+		}
+		break;
+
+	case StringHash("spindles^"):
+		if (currentResponseType == rcvOMKeySpindles)
 		{
 			OM::RemoveSpindle(lastSpindle + 1, true);
 			UI::AllToolsSeen();
 		}
-	}
-	else if (currentResponseType == rcvOMKeyTools)
-	{
-		if (strcasecmp(id, "tools^") == 0)
+		break;
+
+	case StringHash("tools^"):
+		if (currentResponseType == rcvOMKeyTools)
 		{
 			OM::RemoveTool(lastTool + 1, true);
 			UI::AllToolsSeen();
 		}
-		else if (strcasecmp(id, "tools^:extruders^") == 0 && indices[1] == 0)
+		break;
+
+	case StringHash("tools^:extruders^"):
+		if (currentResponseType == rcvOMKeyTools && indices[1] == 0)
 		{
 			UI::SetToolExtruder(indices[0], -1);			// No extruder defined for this tool
 		}
-		else if (strcasecmp(id, "tools^:heaters^") == 0 && indices[1] == 0)
+		break;
+
+	case StringHash("tools^:heaters^"):
+		if (currentResponseType == rcvOMKeyTools && indices[1] == 0)
 		{
 			UI::SetToolHeater(indices[0], -1);				// No heater defined for this tool
 		}
-	}
-	else if (currentResponseType == rcvOMKeyVolumes && strcasecmp(id, "volumes^") == 0)
-	{
-		FileManager::SetNumVolumes(mountedVolumesCounted);
+		break;
+
+	case StringHash("volumes^"):
+		if (currentResponseType == rcvOMKeyVolumes)
+		{
+			FileManager::SetNumVolumes(mountedVolumesCounted);
+		}
+		break;
+
+	default:
+		break;
 	}
 }
 
 void ParserErrorEncountered()
 {
+	++parserErrorCount;
 	MessageLog::AppendMessage("Error parsing response");
 	// TODO: Handle parser errors
 }
@@ -2509,7 +3338,7 @@ int main(void)
 	}
 
 	// Set up the baud rate
-	SerialIo::Init(nvData.baudRate);
+	SwitchBaudRate(GetStartingBaudRate());
 
 	MessageLog::Init();
 
@@ -2543,7 +3372,7 @@ int main(void)
 	mgr.Refresh(true);								// draw the screen for the first time
 	UI::UpdatePrintingFields();
 
-	SerialIo::Sendf("M409 F\"d99f\"\n");		// Get initial status
+	SendStatusRequest(nullptr);					// Get initial status
 	lastPollTime = SystemTick::GetTickCount();
 
 	// Hide all tools and heater related columns initially
@@ -2554,16 +3383,6 @@ int main(void)
 	// Display the Control tab. This also refreshes the display.
 	UI::ShowDefaultPage();
 
-	// Sort the fieldTable
-	qsort(
-			fieldTable,
-			ARRAY_SIZE(fieldTable),
-			sizeof(FieldTableEntry),
-			[](const void* a, const void* b)
-			{
-				return strcasecmp(((FieldTableEntry*) a)->varName, ((FieldTableEntry*) b)->varName);
-			});
-
 	seqs.Reset();
 
 //	lastResponseTime = SystemTick::GetTickCount();	// pretend we just received a response
@@ -2660,20 +3479,36 @@ int main(void)
 		// 6. If it is time, poll the printer status.
 		// When the printer is executing a homing move or other file macro, it may stop responding to polling requests.
 		// Under these conditions, we slow down the rate of polling to avoid building up a large queue of them.
+		// While we are fetching keys whose seqs have changed, we keep several requests in flight so that we don't wait a round trip for each one.
+		// While the printer pushes changes to us, we fetch the keys that it tells us have changed without waiting for the next poll.
 		const uint32_t now = SystemTick::GetTickCount();
+		ExpireStatusRequests(now);
+		SpinBaudRate(now);
+		if (baudState == BaudState::switching)
+		{
+			continue;								// anything we sent now would arrive after the printer has changed baud rate
+		}
+		if (subscribed && initialized && numStatusRequests == 0 && UI::DoPolling())
+		{
+			auto nextToPoll = GetNextToPoll();
+			if (nextToPoll != nullptr)
+			{
+				SendStatusRequest(nextToPoll);
+				lastPollTime = now;
+			}
+		}
 		if (   (UI::DoPolling()										// don't poll while we are in the Setup page
 		    && now - lastPollTime >= printerPollInterval			// if we haven't polled the printer too recently...
 			&& now - lastResponseTime >= printerResponseInterval)	// and we haven't had a response too recently
 			|| (!initialized && (now - lastPollTime > now - lastResponseTime))	// but if we are initializing do it as fast as possible where
 		   )
 		{
-			if (now - lastPollTime > now - lastResponseTime)		// if we've had a response since the last poll
+			if (now - lastPollTime > now - lastResponseTime && numStatusRequests == 0)	// if we've had responses to everything we asked for
 			{
 				auto nextToPoll = GetNextToPoll();
 				if (nextToPoll != nullptr)
 				{
-
-					SerialIo::Sendf("M409 K\"%s\" F\"%s\"\n", nextToPoll->key, nextToPoll->flags);
+					SendStatusRequest(nextToPoll);
 				}
 				else {
 					// Once we get here the first time we will have work all seqs once
@@ -2681,21 +3516,39 @@ int main(void)
 
 					// First check for specific info we need to fetch
 					bool done = FileManager::ProcessTimers();
+#if OFFER_PUSH_SUBSCRIPTION
+					// Then ask the printer to push changes to us, once each time we connect
+					if (!done && !subscriptionRequested)
+					{
+						SendSubscriptionRequest();
+						done = true;
+					}
+#endif
 
 					// Otherwise just send a normal poll command
 					if (!done)
 					{
-						SerialIo::Sendf("M409 F\"d99f\"\n");
+						SendStatusRequest(nullptr);
 					}
 				}
 				lastPollTime = SystemTick::GetTickCount();
 			}
             else if (now - lastPollTime >= printerPollTimeout)      // last response was most likely incomplete start over
             {
-                SerialIo::Sendf("M409 F\"d99f\"\n");
+                BackOffPollRate();
+                SendStatusRequest(nullptr);
                 lastPollTime = SystemTick::GetTickCount();
             }
 		}
+		if (numStatusRequests != 0 && numStatusRequests < statusRequestWindow && (UI::DoPolling() || !initialized))
+		{
+			auto nextToPoll = GetNextToPoll();
+			if (nextToPoll != nullptr)
+			{
+				SendStatusRequest(nextToPoll);
+				lastPollTime = SystemTick::GetTickCount();
+			}
+		}
 		ShowLine;
 	}
 }
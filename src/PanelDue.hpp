@@ -19,9 +19,30 @@
 #include "FirmwareFeatures.hpp"
 #include "General/String.h"
 
+// A value received from the serial I/O module. Numbers are decoded while they are being received, so they don't need to be parsed again.
+struct ReceivedValue
+{
+	enum class Kind : uint8_t
+	{
+		text,				// a string, true, false, or null (in which case the text is empty)
+		integer,			// a number without a decimal point
+		fixedPoint,			// a number with a decimal point, held as magnitude / 10^decimals
+		floatingPoint		// a number with too many digits before the decimal point to fit in the magnitude, so only the text is valid
+	};
+
+	const char* _ecv_array text;		// the characters received, always valid but only until the callback returns because it may point into the receive buffer
+	uint32_t magnitude;					// the absolute value if this is an integer or fixed point number
+	uint8_t decimals;					// the number of digits after the decimal point if this is a fixed point number
+	bool negative;
+	Kind kind;
+};
+
 // Functions called from the serial I/O module
-extern void ProcessReceivedValue(StringRef id, const char val[], const size_t indices[]);
-extern void ProcessArrayEnd(const char id[], const size_t indices[]);
+// Field paths are passed as their StringHash, with letters folded to lower case
+extern uint32_t TranslateRootFieldId(uint32_t idHash);
+extern bool IsFieldIdWanted(uint32_t idHash);
+extern void ProcessReceivedValue(uint32_t idHash, const ReceivedValue& val, const size_t indices[]);
+extern void ProcessArrayEnd(uint32_t idHash, const size_t indices[]);
 extern void StartReceivedMessage();
 extern void EndReceivedMessage();
 extern void ParserErrorEncountered();
@@ -53,6 +74,7 @@ extern void InvertDisplay();
 extern void LandscapeDisplay(const bool withTouch = true);
 extern void PortraitDisplay(const bool withTouch = true);
 extern void SetBaudRate(uint32_t rate);
+extern void SetAutoBaudRate();
 extern void SetBrightness(int percent);
 extern void RestoreBrightness();
 extern void SetVolume(uint8_t newVolume);
@@ -61,6 +83,7 @@ extern void SetScreensaverTimeout(uint32_t screensaverTimeout);
 extern bool SetColourScheme(uint8_t newColours);
 extern bool SetLanguage(uint8_t newLanguage);
 extern uint32_t GetBaudRate();
+extern bool IsAutoBaudRate();
 extern int GetBrightness();
 extern uint32_t GetVolume();
 extern uint32_t GetScreensaverTimeout();
@@ -75,6 +98,12 @@ extern const char* _ecv_array CondStripDrive(const char* _ecv_array arg);
 extern void Reconnect();
 extern void Delay(uint32_t milliSeconds);
 
+// Link diagnostics
+const size_t LinkReportHeaderLines = 6;			// lines of counters before the round trip time histograms
+const size_t MaxLinkReportLineLength = 80;
+extern bool GetLinkReportLine(size_t index, const StringRef& s);
+extern void SendLinkReport();
+
 // Global data in PanelDue.cpp that is used elsewhere
 extern UTFT lcd;
 extern MainWindow mgr;
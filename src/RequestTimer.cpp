@@ -31,6 +31,7 @@ bool RequestTimer::Process()
 
 	if (timerState == ready && OkToSend())
 	{
+		SerialIo::SetCommandClass(SerialIo::CommandClass::fileRequest);
 		SerialIo::Sendf(command);
 		if (extra != nullptr)
 		{
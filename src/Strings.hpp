@@ -74,6 +74,7 @@ struct StringTable
 	CSTRING screensaverAfter;
 	CSTRING babystepAmount;
 	CSTRING feedrate;
+	CSTRING linkDiagnostics;
 
 	// Pendant root
 	CSTRING backToNormal;
@@ -140,6 +141,11 @@ struct StringTable
 	CSTRING simulatedPrintTime;
 	CSTRING simulate;
 
+	// Link diagnostics popup
+	CSTRING refresh;
+	CSTRING more;
+	CSTRING send;
+
 	// Printer status strings
 	CSTRING statusValues[NumStatusStrings];
 
@@ -204,6 +210,7 @@ const StringTable LanguageTables[NumLanguages] =
 		"Screensaver ",						// note space at end
 		"Babystep ",						// note space at end
 		"Feedrate ",						// note space at end
+		"Link diagnostics",
 
 		// Pendant root
 		"Panel",
@@ -270,6 +277,11 @@ const StringTable LanguageTables[NumLanguages] =
 		"Simulated print time: ",
 		"Simulate",
 
+		// Link diagnostics popup
+		"Refresh",
+		"More",
+		"Send",
+
 		// Printer status strings
 		{
 			"Connecting",
@@ -354,6 +366,7 @@ const StringTable LanguageTables[NumLanguages] =
 		"Screensaver ",						// note space at end
 		"Babystep ",						// note space at end
 		"Feedrate ",						// note space at end
+		"Verbindungsdiagnose",
 
 		// Pendant root
 		"Panel",
@@ -420,6 +433,11 @@ const StringTable LanguageTables[NumLanguages] =
 		"Errechnete Druckdauer: ",
 		"Simulieren",
 
+		// Link diagnostics popup
+		"Aktualisieren",
+		"Mehr",
+		"Senden",
+
 		// Printer status strings
 		{
 			"Verbinde",
@@ -503,6 +521,7 @@ const StringTable LanguageTables[NumLanguages] =
 		"Screensaver ",							// note space at end
 		"Babystep ",							// note space at end
 		"Feedrate ",							// note space at end
+		"Diagnostic liaison",
 
 		// Pendant root
 		"Panel",
@@ -569,6 +588,11 @@ const StringTable LanguageTables[NumLanguages] =
 		"Temps d'impression simulé: ",
 		"Simuler",
 
+		// Link diagnostics popup
+		"Actualiser",
+		"Plus",
+		"Envoyer",
+
 		// Printer status strings
 		{
 			"Liaison en cours",					// "Connexion en cours" was too long
@@ -652,6 +676,7 @@ const StringTable LanguageTables[NumLanguages] =
 		"Screensaver ",						// note space at end
 		"Babystep ",						// note space at end
 		"Feedrate ",						// note space at end
+		"Diagnóstico enlace",
 
 		// Pendant root
 		"Panel",
@@ -718,6 +743,11 @@ const StringTable LanguageTables[NumLanguages] =
 		"Tiempo de impresión simulado: ",
 		"Simular",
 
+		// Link diagnostics popup
+		"Actualizar",
+		"Más",
+		"Enviar",
+
 		// Printer status strings
 		{
 			"conexión",
@@ -801,6 +831,7 @@ const StringTable LanguageTables[NumLanguages] =
 		"Screensaver ",						// note space at end
 		"Babystep ",						// note space at end
 		"Feedrate ",						// note space at end
+		"Diagnostika linky",
 
 		// Pendant root
 		"Panel",
@@ -867,6 +898,11 @@ const StringTable LanguageTables[NumLanguages] =
 		"Simulovaný čas tisku: ",
 		"Simulace",
 
+		// Link diagnostics popup
+		"Obnovit",
+		"Více",
+		"Odeslat",
+
 		// Printer status strings
 		{
 			"Připojování",
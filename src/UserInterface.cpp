@@ -68,6 +68,10 @@ static StaticTextField *areYouSureTextField, *areYouSureQueryField;
 static PopupWindow *areYouSurePopupP, *extrudePopupP, *wcsOffsetsPopup;
 static FloatButton* wcsOffsetPos[ARRAY_SIZE(jogAxes)];
 static IconButton* wcsSetToCurrent[ARRAY_SIZE(jogAxes)];
+static PopupWindow *linkDiagnosticsPopup;
+static StaticTextField *linkReportFields[8];
+static String<MaxLinkReportLineLength> linkReportText[ARRAY_SIZE(linkReportFields)];
+static size_t linkReportFirstLine = 0;
 static StaticTextField *areYouSureTextFieldP, *areYouSureQueryFieldP;
 static DisplayField *emptyRoot, *baseRoot, *commonRoot, *controlRoot, *printRoot, *messageRoot, *setupRoot,
 		*pendantBaseRoot, *pendantJogRoot, *pendantOffsetRoot, *pendantJobRoot;
@@ -103,8 +107,8 @@ static IntegerButton *activeTempPJog, *standbyTempPJog;
 static IntegerButton *activeTempsPJob[MaxPendantTools], *standbyTempsPJob[MaxPendantTools];
 static IntegerField *currentToolField;
 static StaticTextField *currentWCSField;
-static IntegerButton *spd, *extrusionFactors[MaxSlots], *fanSpeed, *baudRateButton, *volumeButton, *infoTimeoutButton, *screensaverTimeoutButton, *feedrateAmountButton;
-static TextButton *languageButton, *coloursButton, *dimmingTypeButton;
+static IntegerButton *spd, *extrusionFactors[MaxSlots], *fanSpeed, *volumeButton, *infoTimeoutButton, *screensaverTimeoutButton, *feedrateAmountButton;
+static TextButton *languageButton, *coloursButton, *dimmingTypeButton, *baudRateButton;
 static TextButtonWithLabel *babystepAmountButton;
 static SingleButton *moveButton, *extrudeButton, *macroButton;
 static PopupWindow *babystepPopup;
@@ -129,6 +133,7 @@ static String<generatedByTextLength> generatedByText;
 static String<lastModifiedTextLength> lastModifiedText;
 static String<printTimeTextLength> printTimeText;
 static String<ipAddressLength> ipAddress;
+static String<12> baudRateText;							// "115200 baud", or "Auto" when we negotiate the baud rate
 
 const size_t maxUserCommandLength = 40;					// max length of a user gcode command
 const size_t numUserCommandBuffers = 6;					// number of command history buffers plus one
@@ -168,7 +173,7 @@ static bool allAxesHomed = false;
 # include "Hardware/RotaryEncoder.hpp"
 
 static RotaryEncoder *encoder;
-static uint32_t lastEncoderCommandSentAt = 0;
+static uint32_t lastEncoderSampleAt = 0;
 static ButtonPress currentJogAxis, currentJogAmount;
 static bool isLandscape = false;
 
@@ -1017,6 +1022,37 @@ void CreateFileActionPopup(const ColourScheme& colours)
 	fileDetailPopup->AddField(new IconButton(popupTopMargin + 10 * rowTextHeight, (2 * fileInfoPopupWidth)/3 + popupSideMargin, fileInfoPopupWidth/3 - 2 * popupSideMargin, IconTrash, evDeleteFile));
 }
 
+// Create the popup window used to display the link diagnostics, a page at a time
+void CreateLinkDiagnosticsPopup(const ColourScheme& colours)
+{
+	linkDiagnosticsPopup = new StandardPopupWindow(fileInfoPopupHeight, fileInfoPopupWidth, colours.popupBackColour, colours.popupBorderColour, colours.popupTextColour, colours.buttonImageBackColour, strings->linkDiagnostics);
+	DisplayField::SetDefaultColours(colours.popupTextColour, colours.popupBackColour);
+	PixelNumber ypos = popupTopMargin + (3 * rowTextHeight)/2;
+	for (StaticTextField*& f : linkReportFields)
+	{
+		f = new StaticTextField(ypos, popupSideMargin, fileInfoPopupWidth - 2 * popupSideMargin, TextAlignment::Left, nullptr);
+		linkDiagnosticsPopup->AddField(f);
+		ypos += rowTextHeight;
+	}
+
+	// Add the buttons
+	DisplayField::SetDefaultColours(colours.popupButtonTextColour, colours.popupButtonBackColour);
+	linkDiagnosticsPopup->AddField(new TextButton(popupTopMargin + 10 * rowTextHeight, popupSideMargin, fileInfoPopupWidth/3 - 2 * popupSideMargin, strings->refresh, evRefreshLinkDiagnostics));
+	linkDiagnosticsPopup->AddField(new TextButton(popupTopMargin + 10 * rowTextHeight, fileInfoPopupWidth/3 + popupSideMargin, fileInfoPopupWidth/3 - 2 * popupSideMargin, strings->more, evMoreLinkDiagnostics));
+	linkDiagnosticsPopup->AddField(new TextButton(popupTopMargin + 10 * rowTextHeight, (2 * fileInfoPopupWidth)/3 + popupSideMargin, fileInfoPopupWidth/3 - 2 * popupSideMargin, strings->send, evSendLinkReport));
+}
+
+// Show a page of the link diagnostics report starting at the specified line
+static void ShowLinkDiagnostics(size_t firstLine)
+{
+	linkReportFirstLine = firstLine;
+	for (size_t i = 0; i < ARRAY_SIZE(linkReportFields); ++i)
+	{
+		(void)GetLinkReportLine(firstLine + i, linkReportText[i].GetRef());		// this leaves the text empty if there is no such line
+		linkReportFields[i]->SetValue(linkReportText[i].c_str(), true);
+	}
+}
+
 // Create the "Are you sure?" popup
 void CreateAreYouSurePopup(const ColourScheme& colours)
 {
@@ -1055,12 +1091,26 @@ void CreateScreensaverPopup()
 	LandscapeDisplay(false);
 }
 
+// Show the baud rate we are set to on the Setup page. When it is negotiated, the rate we are at may change, so we just say that.
+static void UpdateBaudRateButton()
+{
+	if (IsAutoBaudRate())
+	{
+		baudRateText.copy("Auto");
+	}
+	else
+	{
+		baudRateText.printf("%u baud", (unsigned int)GetBaudRate());
+	}
+	baudRateButton->SetChanged();
+}
+
 // Create the baud rate adjustment popup
 void CreateBaudRatePopup(const ColourScheme& colours)
 {
-	static const char* const baudPopupText[] = { "9600", "19200", "38400", "57600", "115200" };
-	static const int baudPopupParams[] = { 9600, 19200, 38400, 57600, 115200 };
-	baudPopup = CreateIntPopupBar(colours, fullPopupWidth, 5, baudPopupText, baudPopupParams, evAdjustBaudRate, evAdjustBaudRate);
+	static const char* const baudPopupText[] = { "9600", "19200", "38400", "57600", "115200", "Auto" };
+	static const int baudPopupParams[] = { 9600, 19200, 38400, 57600, 115200, 0 };		// 0 means negotiate up from the rate we are at now
+	baudPopup = CreateIntPopupBar(colours, fullPopupWidth, ARRAY_SIZE(baudPopupParams), baudPopupText, baudPopupParams, evAdjustBaudRate, evAdjustBaudRate);
 }
 
 // Create the volume adjustment popup
@@ -1447,8 +1497,8 @@ void CreateSetupTabFields(uint32_t language, const ColourScheme& colours)
 	mgr.AddField(new ColourGradientField(ColourGradientTopPos, ColourGradientLeftPos, ColourGradientWidth, ColourGradientHeight));
 
 	DisplayField::SetDefaultColours(colours.buttonTextColour, colours.buttonTextBackColour);
-	baudRateButton = AddIntegerButton(row3, 0, 3, nullptr, " baud", evSetBaudRate);
-	baudRateButton->SetValue(GetBaudRate());
+	baudRateButton = AddTextButton(row3, 0, 3, baudRateText.c_str(), evSetBaudRate, nullptr);
+	UpdateBaudRateButton();
 	volumeButton = AddIntegerButton(row3, 1, 3, strings->volume, nullptr, evSetVolume);
 	volumeButton->SetValue(GetVolume());
 	languageButton = AddTextButton(row3, 2, 3, LanguageTables[language].languageName, evSetLanguage, nullptr);
@@ -1470,6 +1520,7 @@ void CreateSetupTabFields(uint32_t language, const ColourScheme& colours)
 
 	feedrateAmountButton = AddIntegerButton(row7, 2, 3, strings->feedrate, nullptr, evSetFeedrate);
 	feedrateAmountButton->SetValue(GetFeedrate());
+	AddTextButton(row8, 0, 3, strings->linkDiagnostics, evLinkDiagnostics, nullptr);
 
 	mgr.AddField(ipAddressField = new TextField(row9, margin, DisplayX/2 - margin, TextAlignment::Left, "IP: ", ipAddress.c_str()));
 	setupRoot = mgr.GetRoot();
@@ -1869,6 +1920,9 @@ namespace UI
 
 		// Set up default colours and margins
 		mgr.Init(colours.defaultBackColour);
+#ifdef DEFAULT_FONT_METRICS
+		UTFT::AddFontMetrics(DEFAULT_FONT_METRICS);			// without these, text is measured by printing it off the screen
+#endif
 		DisplayField::SetDefaultFont(DEFAULT_FONT);
 		ButtonWithText::SetFont(DEFAULT_FONT);
 		CharButtonRow::SetFont(DEFAULT_FONT);
@@ -1897,6 +1951,7 @@ namespace UI
 		CreateBabystepAmountPopup(colours);
 		CreateFeedrateAmountPopup(colours);
 		CreateBaudRatePopup(colours);
+		CreateLinkDiagnosticsPopup(colours);
 		CreateColoursPopup(colours);
 		CreateAreYouSurePopup(colours);
 		CreateKeyboardPopup(language, colours);
@@ -2428,6 +2483,26 @@ namespace UI
 		return currentTab != tabSetup;			// don't poll while we are on the Setup page
 	}
 
+	DisplayedView GetDisplayedView()
+	{
+		const PopupWindow * const popup = mgr.GetPopup();
+		if (popup != nullptr && (popup == fileListPopup || popup == fileDetailPopup))
+		{
+			return DisplayedView::fileList;
+		}
+		if (popup != nullptr && (popup == macrosPopup || popup == macrosPopupP))
+		{
+			return DisplayedView::macroList;
+		}
+		return (currentTab == tabPrint) ? DisplayedView::print
+			: (currentTab == tabMsg) ? DisplayedView::console
+			: (currentTab == tabSetup) ? DisplayedView::setup
+			: (currentTab == tabJog) ? DisplayedView::jog
+			: (currentTab == tabOffset) ? DisplayedView::offset
+			: (currentTab == tabJob) ? DisplayedView::job
+			: DisplayedView::control;
+	}
+
 	void Tick()
 	{
 #ifdef SUPPORT_ENCODER
@@ -2436,6 +2511,95 @@ namespace UI
 	}
 
 #ifdef SUPPORT_ENCODER
+	// Encoder jogging.
+	// The clicks received in each sampling interval are sent as a single move. When the wheel is turning fast each click moves the axis further
+	// and the feed rate goes up to match, following EncoderJogAccelerationCurve. We estimate when each move will finish and allow only a few moves
+	// and a limited distance to be outstanding, discarding most of the clicks that arrive in the meantime, so that the axis stops soon after the wheel does.
+	static int pendingJogClicks = 0;
+	static float encoderClicksPerSecond = 0.0;					// how fast the wheel is turning, smoothed over a few samples
+	static uint32_t jogMoveEndTimes[MaxEncoderJogMovesInFlight] = { 0 };	// when we expect the moves we have sent to finish
+	static float jogMoveDistances[MaxEncoderJogMovesInFlight] = { 0.0 };	// how far those moves go
+
+	static unsigned int GetJogAccelerationFactor()
+	{
+		unsigned int factor = 1;
+		for (const EncoderJogAcceleration& step : EncoderJogAccelerationCurve)
+		{
+			if (encoderClicksPerSecond >= step.clicksPerSecond)
+			{
+				factor = step.factor;
+			}
+		}
+		return factor;
+	}
+
+	// Estimate how long a jog move takes in milliseconds, accelerating from rest and decelerating to rest at EncoderJogMachineAcceleration
+	static uint32_t GetJogMoveTime(float distance, unsigned int feedRate)
+	{
+		const float speed = (float)feedRate/60.0f;				// mm/s
+		const float accelDistance = speed * speed/EncoderJogMachineAcceleration;	// distance needed to accelerate to full speed and back
+		const float seconds = (distance >= accelDistance)
+								? distance/speed + speed/EncoderJogMachineAcceleration
+								: 2.0f * sqrtf(distance/EncoderJogMachineAcceleration);	// the move never reaches full speed
+		return (uint32_t)(seconds * 1000.0f) + EncoderJogMoveOverhead;
+	}
+
+	static void SendPendingJog(uint32_t now)
+	{
+		if (pendingJogClicks == 0)
+		{
+			return;
+		}
+		if (   currentTab != tabJog || GetStatus() == PrinterStatus::printing
+			|| !currentJogAxis.IsValid() || !currentJogAmount.IsValid()
+		   )
+		{
+			pendingJogClicks = 0;
+			return;
+		}
+
+		// Find a free entry for the move, when the printer will have finished the ones already sent, and how far they still go
+		size_t slot = MaxEncoderJogMovesInFlight;
+		uint32_t startTime = now;
+		float distanceInFlight = 0.0;
+		for (size_t i = 0; i < MaxEncoderJogMovesInFlight; ++i)
+		{
+			const uint32_t t = jogMoveEndTimes[i];
+			if ((int32_t)(t - now) <= 0)
+			{
+				slot = i;
+			}
+			else
+			{
+				distanceInFlight += jogMoveDistances[i];
+				if ((int32_t)(t - startTime) > 0)
+				{
+					startTime = t;
+				}
+			}
+		}
+
+		const float jogAmount = currentJogAmount.GetFParam();
+		const float maxDistance = max<float>(MaxEncoderJogDistanceInFlight, jogAmount) - distanceInFlight;
+		if (slot == MaxEncoderJogMovesInFlight || maxDistance < jogAmount)
+		{
+			// Too many moves are outstanding. Don't let clicks pile up meanwhile, or the axis would keep moving after the wheel stops.
+			pendingJogClicks = constrain<int>(pendingJogClicks, -(int)MaxEncoderJogClicksHeld, (int)MaxEncoderJogClicksHeld);
+			return;
+		}
+
+		// Clicks beyond the distance we allow in flight are discarded
+		const unsigned int factor = GetJogAccelerationFactor();
+		const float distance = constrain<float>(pendingJogClicks * jogAmount * factor, -maxDistance, maxDistance);
+		const unsigned int feedRate = min<unsigned int>((jogAmount < 5.0f ? 6000 : 12000) * factor, MaxEncoderJogFeedRate);
+		TextButtonForAxis *textButton = static_cast<TextButtonForAxis*>(currentJogAxis.GetButton());
+		SerialIo::SetCommandClass(SerialIo::CommandClass::jog);
+		SerialIo::Sendf("G91 G0 %c%.3f F%d G90\n", textButton->GetAxisLetter(), distance, feedRate);
+		jogMoveEndTimes[slot] = startTime + GetJogMoveTime(fabsf(distance), feedRate);
+		jogMoveDistances[slot] = fabsf(distance);
+		pendingJogClicks = 0;
+	}
+
 	void HandleEncoderChange(const int change)
 	{
 		auto status = GetStatus();
@@ -2499,23 +2663,14 @@ namespace UI
 			return;
 		}
 
-		bool sent = false;
 		// Jog axis around
 		if (currentTab == tabJog && status != PrinterStatus::printing)
 		{
 			if (currentJogAxis.IsValid() && currentJogAmount.IsValid())
 			{
-				const float jogAmount = currentJogAmount.GetFParam();
-				const unsigned int feedRate = jogAmount < 5.0f ? 6000 : 12000;
-				TextButtonForAxis *textButton = static_cast<TextButtonForAxis*>(currentJogAxis.GetButton());
-				SerialIo::Sendf("G91 G0 %c%.3f F%d G90\n", textButton->GetAxisLetter(), change * jogAmount, feedRate);
-				sent = true;
+				pendingJogClicks += change;			// SendPendingJog will send them
 			}
 		}
-
-		if (sent) {
-			lastEncoderCommandSentAt = SystemTick::GetTickCount();
-		}
 	}
 #endif
 
@@ -2523,14 +2678,19 @@ namespace UI
 	void Spin()
 	{
 #ifdef SUPPORT_ENCODER
-		if (SystemTick::GetTickCount() - lastEncoderCommandSentAt >= MinimumEncoderCommandInterval)
+		const uint32_t now = SystemTick::GetTickCount();
+		const uint32_t sinceLastSample = now - lastEncoderSampleAt;
+		if (sinceLastSample >= MinimumEncoderCommandInterval)
 		{
 			// Check encoder and command movement
+			lastEncoderSampleAt = now;
 			const int ch = encoder->GetChange();
+			encoderClicksPerSecond = 0.75f * encoderClicksPerSecond + 0.25f * (float)abs(ch) * 1000.0f/(float)sinceLastSample;	// so one click after a pause is slow
 			if (ch != 0)
 			{
 				HandleEncoderChange(ch);
 			}
+			SendPendingJog(now);
 		}
 #endif
 
@@ -3072,7 +3232,9 @@ namespace UI
 
 	static void DoEmergencyStop()
 	{
-		// We send M112 for the benefit of old firmware, and F0 0F (an invalid UTF8 sequence) for new firmware
+		// We send M112 for the benefit of old firmware, and F0 0F (an invalid UTF8 sequence) for new firmware.
+		// It goes ahead of anything else waiting to be sent, and whatever was waiting is discarded.
+		SerialIo::SetCommandClass(SerialIo::CommandClass::emergency);
 		SerialIo::Sendf("M112 ;" "\xF0" "\x0F" "\n");
 		TouchBeep();											// needed when we are called from ProcessTouchOutsidePopup
 		Delay(1000);
@@ -3391,6 +3553,7 @@ namespace UI
 			case evMoveAxisP:
 				{
 					TextButtonForAxis *textButton = static_cast<TextButtonForAxis*>(bp.GetButton());
+					SerialIo::SetCommandClass(SerialIo::CommandClass::jog);
 					SerialIo::Sendf("G91 G1 %c%s F%d G90\n", textButton->GetAxisLetter(), bp.GetSParam(), GetFeedrate());
 				}
 				break;
@@ -3507,6 +3670,28 @@ namespace UI
 				PopupAreYouSure(ev, strings->confirmFactoryReset);
 				break;
 
+			case evLinkDiagnostics:
+				mgr.SetPopup(linkDiagnosticsPopup, AutoPlace, AutoPlace);
+				ShowLinkDiagnostics(0);
+				break;
+
+			case evRefreshLinkDiagnostics:
+				ShowLinkDiagnostics(linkReportFirstLine);
+				break;
+
+			case evMoreLinkDiagnostics:
+				{
+					// Go on to the next page if there is one, else back to the start
+					String<MaxLinkReportLineLength> line;
+					const size_t nextLine = linkReportFirstLine + ARRAY_SIZE(linkReportFields);
+					ShowLinkDiagnostics((GetLinkReportLine(nextLine, line.GetRef())) ? nextLine : 0);
+				}
+				break;
+
+			case evSendLinkReport:
+				SendLinkReport();
+				break;
+
 			case evSelectBed:
 				{
 					const auto bed = OM::GetFirstBed();
@@ -3581,6 +3766,7 @@ namespace UI
 						{
 							// It's a regular file
 							currentFile = fileName;
+							SerialIo::SetCommandClass(SerialIo::CommandClass::fileRequest);
 							SerialIo::Sendf(((GetFirmwareFeatures() & noM20M36) == 0) ? "M36 " : "M408 S36 P");			// ask for the file info
 							SerialIo::SendFilename(CondStripDrive(FileManager::GetFilesDir()), currentFile);
 							SerialIo::SendChar('\n');
@@ -3715,8 +3901,15 @@ namespace UI
 			case evAdjustBaudRate:
 				{
 					const int rate = bp.GetIParam();
-					SetBaudRate(rate);
-					baudRateButton->SetValue(rate);
+					if (rate == 0)
+					{
+						SetAutoBaudRate();
+					}
+					else
+					{
+						SetBaudRate(rate);
+					}
+					UpdateBaudRateButton();
 				}
 				CurrentButtonReleased();
 				mgr.ClearPopup();
@@ -4053,6 +4246,7 @@ namespace UI
 			case evInvertX:
 			case evInvertY:
 			case evFactoryReset:
+			case evLinkDiagnostics:
 				// On the Setup tab, we allow any other button to be pressed to exit the current popup
 				StopAdjusting();
 				DelayTouchLong();	// by default, ignore further touches for a long time
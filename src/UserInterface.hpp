@@ -40,6 +40,13 @@ namespace UI
 	extern void UpdateTimesLeft(size_t index, unsigned int seconds);
 	extern bool ChangePage(ButtonBase *newTab);
 	extern bool DoPolling();
+
+	// What the user is looking at, so that we can fetch the parts of the object model that it shows first
+	enum class DisplayedView : uint8_t
+	{
+		control, print, console, setup, jog, offset, job, fileList, macroList
+	};
+	extern DisplayedView GetDisplayedView();
 	extern void Tick();
 	extern void Spin();
 	extern void PrintStarted();
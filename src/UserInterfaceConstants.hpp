@@ -12,6 +12,8 @@
 #include "DisplaySize.hpp"
 #include "Library/Misc.hpp"
 
+struct FontMetrics;
+
 const size_t NumColourSchemes = 3;
 
 #ifdef OEM_LAYOUT
@@ -75,6 +77,8 @@ const PixelNumber ColourGradientWidth = 2 * 128;
 
 extern uint8_t glcd19x21[];				// declare which fonts we will be using
 #define DEFAULT_FONT	glcd19x21
+extern const FontMetrics glcd19x21Metrics;
+#define DEFAULT_FONT_METRICS	glcd19x21Metrics
 
 #elif DISPLAY_X == 800
 const unsigned int MaxSlots = 7;
@@ -124,6 +128,8 @@ const PixelNumber ColourGradientWidth = 3 * 128;
 
 extern uint8_t glcd28x32[];				// declare which fonts we will be using
 #define DEFAULT_FONT	glcd28x32
+extern const FontMetrics glcd28x32Metrics;
+#define DEFAULT_FONT_METRICS	glcd28x32Metrics
 
 #else
 